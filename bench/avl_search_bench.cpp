@@ -0,0 +1,66 @@
+/*
+Search throughput of AVLTree before and after freeze().
+
+For each size the tree holds the even keys 0, 2, 4, ...; the queries are
+random keys of which about half are present. The same queries are run
+against the pointer tree and against the frozen Eytzinger index.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -Iinclude bench/avl_search_bench.cpp src/AVLTree.cpp -o avl_search_bench
+    ./avl_search_bench [size ...]        (default: 1000000 100000000)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "AVLTree.h"
+
+// Runs every query and returns million lookups per second
+static double runQueries(const AVLTree& tree, const std::vector<int>& queries, long long& hits) {
+    auto start = std::chrono::steady_clock::now();
+    for (int key : queries) {
+        hits += tree.contains(key);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return queries.size() / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::vector<long> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atol(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes.push_back(1000000);
+        sizes.push_back(100000000);
+    }
+
+    const int queryCount = 5000000;
+    std::cout << "keys        pointer tree (M/s)  frozen index (M/s)\n";
+    for (long n : sizes) {
+        std::vector<int> keys(n);
+        for (long i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(2 * i);
+        }
+        AVLTree tree;
+        tree.buildTree(keys.data(), static_cast<int>(n));
+        keys.clear();
+        keys.shrink_to_fit();
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<long> pick(0, 2 * n - 1);
+        std::vector<int> queries(queryCount);
+        for (int& query : queries) {
+            query = static_cast<int>(pick(rng));
+        }
+
+        long long hits = 0;
+        double treeRate = runQueries(tree, queries, hits);
+        tree.freeze();
+        double frozenRate = runQueries(tree, queries, hits);
+        std::cout << n << "    " << treeRate << "            " << frozenRate << "    (hits " << hits / 2 << ")\n";
+    }
+    return 0;
+}
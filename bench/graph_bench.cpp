@@ -0,0 +1,110 @@
+/*
+Shortest-path benchmark on a road-like grid graph.
+
+The graph is a side x side grid (default 1000 x 1000, i.e. 1M vertices and
+about 2M edges) with random weights in [1, 100]. Random source/destination
+pairs are answered with Graph::computeShortestPath; the first query also
+pays for building the CSR snapshot. The same pairs are then answered as one
+Graph::computeShortestPaths batch, and again after Graph::buildHierarchy;
+all checksums must agree. One full single-source run is also timed with
+Dijkstra and with delta-stepping.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -Iinclude bench/graph_bench.cpp src/Graph.cpp src/DisjointSet.cpp src/ContractionHierarchy.cpp src/ThreadPool.cpp -pthread -o graph_bench
+    ./graph_bench [side] [queries]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Graph.h"
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 20;
+    int vertices = side * side;
+
+    std::minstd_rand rng(1);
+    int (*edges)[3] = new int[2 * vertices][3];
+    int edgeCount = 0;
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < side; ++col) {
+            int v = row * side + col;
+            if (col + 1 < side) {
+                edges[edgeCount][0] = v;
+                edges[edgeCount][1] = v + 1;
+                edges[edgeCount][2] = 1 + static_cast<int>(rng() % 100);
+                ++edgeCount;
+            }
+            if (row + 1 < side) {
+                edges[edgeCount][0] = v;
+                edges[edgeCount][1] = v + side;
+                edges[edgeCount][2] = 1 + static_cast<int>(rng() % 100);
+                ++edgeCount;
+            }
+        }
+    }
+    Graph graph(vertices);
+    graph.buildGraph(edges, edgeCount);
+    delete[] edges;
+    std::cout << side << " x " << side << " grid: " << vertices << " vertices, " << edgeCount << " edges\n";
+
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& pair : pairs) {
+        pair.first = static_cast<int>(rng() % vertices);
+        pair.second = static_cast<int>(rng() % vertices);
+    }
+
+    double total = 0;
+    long long checksum = 0;
+    for (int i = 0; i < queries; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        checksum += graph.computeShortestPath(pairs[i].first, pairs[i].second);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        total += seconds;
+        if (i == 0) {
+            std::cout << "first query (includes CSR build): " << seconds * 1e3 << " ms\n";
+        }
+    }
+    std::cout << "Dijkstra average over " << queries << " queries: " << total / queries * 1e3 << " ms"
+              << " (checksum " << checksum << ")\n";
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> costs = graph.computeShortestPaths(pairs);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    checksum = 0;
+    for (int cost : costs) {
+        checksum += cost;
+    }
+    std::cout << "batch of " << queries << " queries: " << seconds * 1e3 / queries << " ms per query"
+              << " (checksum " << checksum << ")\n";
+
+    start = std::chrono::steady_clock::now();
+    std::vector<int> dijkstra = graph.computeDistances(pairs[0].first);
+    double dijkstraSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    std::vector<int> deltaStepping = graph.computeDistances(pairs[0].first, ShortestPathMethod::DeltaStepping);
+    double deltaSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "single source, all vertices: Dijkstra " << dijkstraSeconds * 1e3 << " ms, delta-stepping "
+              << deltaSeconds * 1e3 << " ms on " << std::thread::hardware_concurrency() << " threads ("
+              << (dijkstra == deltaStepping ? "distances match" : "DISTANCES DIFFER") << ")\n";
+
+    start = std::chrono::steady_clock::now();
+    graph.buildHierarchy();
+    std::cout << "contraction hierarchy build: "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s\n";
+
+    total = 0;
+    checksum = 0;
+    for (int i = 0; i < queries; ++i) {
+        start = std::chrono::steady_clock::now();
+        checksum += graph.computeShortestPath(pairs[i].first, pairs[i].second);
+        total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout << "hierarchy average over " << queries << " queries: " << total / queries * 1e3 << " ms"
+              << " (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+Scaling benchmark for ConcurrentHashTable.
+
+Every thread draws random keys from a fixed range and runs a read/write mix:
+a read is a membership test, a write inserts or erases with equal chance, so
+the table stays near half full. The 95/5 and 50/50 mixes are run against
+HashTable behind one global mutex and against ConcurrentHashTable, for 1, 2,
+4, ... up to the hardware thread count.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -pthread -Iinclude bench/hashtable_bench.cpp src/HashTable.cpp src/BloomFilter.cpp src/RoaringSet.cpp src/PerfectHashIndex.cpp src/ConcurrentHashTable.cpp -o hashtable_bench
+    ./hashtable_bench [operations per thread] [key range]
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "ConcurrentHashTable.h"
+#include "HashTable.h"
+
+// HashTable serialized by a single mutex, the baseline being replaced
+class LockedTable {
+private:
+    std::mutex lock;
+    HashTable table;
+
+public:
+    explicit LockedTable(int size) : table(size) {}
+
+    bool insert(int key) {
+        std::lock_guard<std::mutex> guard(lock);
+        int before = table.getSize();
+        table.insert(key);
+        return table.getSize() != before;
+    }
+
+    bool erase(int key) {
+        std::lock_guard<std::mutex> guard(lock);
+        return table.erase(key);
+    }
+
+    bool contains(int key) {
+        std::lock_guard<std::mutex> guard(lock);
+        return table.contains(key);
+    }
+};
+
+// Runs the mix on threads threads and returns million operations per second
+template <typename Table>
+double runMix(Table& table, int threads, int operations, int readPercent, int range) {
+    std::vector<std::thread> workers;
+    std::atomic<long> hits(0);
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&table, &hits, operations, readPercent, range, t]() {
+            std::minstd_rand rng(t + 1);
+            long found = 0;
+            for (int i = 0; i < operations; ++i) {
+                int key = static_cast<int>(rng() % range);
+                int roll = static_cast<int>(rng() % 100);
+                if (roll < readPercent) {
+                    found += table.contains(key);
+                } else if (roll & 1) {
+                    table.insert(key);
+                } else {
+                    table.erase(key);
+                }
+            }
+            hits.fetch_add(found);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 1.0 * threads * operations / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int operations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    int range = argc > 2 ? std::atoi(argv[2]) : 1 << 20;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    for (int readPercent : {95, 50}) {
+        std::cout << readPercent << "/" << 100 - readPercent << " read/write, " << operations
+                  << " operations per thread, keys in [0, " << range << ")\n";
+        std::cout << "threads  locked HashTable (Mops/s)  ConcurrentHashTable (Mops/s)\n";
+        for (int threads = 1;; threads *= 2) {
+            if (threads > maxThreads) {
+                threads = maxThreads;
+            }
+            LockedTable locked(range / 2);
+            ConcurrentHashTable concurrent(range / 2);
+            std::minstd_rand rng(threads);
+            for (int i = 0; i < range / 2; ++i) {
+                int key = static_cast<int>(rng() % range);
+                locked.insert(key);
+                concurrent.insert(key);
+            }
+            double lockedRate = runMix(locked, threads, operations, readPercent, range);
+            double concurrentRate = runMix(concurrent, threads, operations, readPercent, range);
+            std::cout << threads << "        " << lockedRate << "                    " << concurrentRate << "\n";
+            if (threads == maxThreads) {
+                break;
+            }
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
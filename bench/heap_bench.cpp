@@ -0,0 +1,119 @@
+/*
+Benchmark for the templated Heap.
+
+Compares a heap whose comparator is a compile-time functor (MinHeap, i.e.
+Heap<int, std::less<int>>) against the same heap driven through a
+bool (*)(int, int) function pointer, which is how every comparison was
+dispatched before Heap became a template. A 64-bit key heap and a key/payload
+pair heap are timed as well.
+
+The second part measures extract-min throughput of binary, 4-ary and 8-ary
+int heaps built from the same keys (default 10M elements), which is where
+the cache-line-aligned sibling groups matter.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -Iinclude bench/heap_bench.cpp -o heap_bench
+    ./heap_bench [elements] [large-heap elements]
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "MinHeap.h"
+
+// Builds a heap from keys and extracts every element; returns seconds spent extracting
+template <typename HeapType>
+double runExtract(const std::vector<int>& keys, long long& checksum) {
+    HeapType heap;
+    heap.buildHeap(keys.data(), static_cast<int>(keys.size()));
+    auto start = std::chrono::steady_clock::now();
+    int previous = heap.top();
+    while (!heap.isEmpty()) {
+        int key = heap.extract();
+        if (key < previous) {
+            std::cerr << "heap order violated" << std::endl;
+            std::exit(1);
+        }
+        previous = key;
+        checksum += key & 1;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+static bool lessThan(int a, int b) {
+    return a < b;
+}
+
+// Inserts every key, then extracts them all; returns seconds and a checksum
+template <typename HeapType, typename Key>
+double runHeap(HeapType& heap, const std::vector<Key>& keys, long long& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (const Key& key : keys) {
+        heap.insert(key);
+    }
+    while (!heap.isEmpty()) {
+        checksum += static_cast<long long>(heap.extract() & 1);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::mt19937_64 rng(42);
+    std::vector<int> keys(n);
+    std::vector<int64_t> wideKeys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(rng());
+        wideKeys[i] = static_cast<int64_t>(rng());
+    }
+
+    // volatile keeps the compiler from constant-propagating the pointer back into a direct call
+    bool (*volatile pointer)(int, int) = lessThan;
+    Heap<int, bool (*)(int, int)> pointerHeap(pointer);
+    MinHeap staticHeap;
+    MinHeapOf<int64_t> wideHeap;
+
+    long long checksum = 0;
+    double pointerTime = runHeap(pointerHeap, keys, checksum);
+    double staticTime = runHeap(staticHeap, keys, checksum);
+    double wideTime = runHeap(wideHeap, wideKeys, checksum);
+
+    MinPairHeap<int64_t, int> pairHeap;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        pairHeap.insert({wideKeys[i], i});
+    }
+    while (!pairHeap.isEmpty()) {
+        checksum += pairHeap.extract().second & 1;
+    }
+    double pairTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double perOp = 1e9 / (2.0 * n);
+    std::cout << "elements: " << n << " (insert all, then extract all)\n";
+    std::cout << "function pointer Heap<int>:  " << pointerTime * perOp << " ns/op\n";
+    std::cout << "static MinHeap (int):        " << staticTime * perOp << " ns/op\n";
+    std::cout << "static MinHeapOf<int64_t>:   " << wideTime * perOp << " ns/op\n";
+    std::cout << "static MinPairHeap<int64,int>: " << pairTime * perOp << " ns/op\n";
+    std::cout << "speedup over function pointer: " << pointerTime / staticTime << "x\n";
+
+    int large = argc > 2 ? std::atoi(argv[2]) : 10000000;
+    std::vector<int> largeKeys(large);
+    for (int& key : largeKeys) {
+        key = static_cast<int>(rng());
+    }
+    double binaryTime = runExtract<MinHeap>(largeKeys, checksum);
+    double fourTime = runExtract<DaryMinHeap<int, 4>>(largeKeys, checksum);
+    double eightTime = runExtract<DaryMinHeap<int, 8>>(largeKeys, checksum);
+    double perExtract = 1e9 / large;
+    std::cout << "\nextract-min on " << large << " elements\n";
+    std::cout << "binary MinHeap: " << binaryTime * perExtract << " ns/extract\n";
+    std::cout << "4-ary MinHeap:  " << fourTime * perExtract << " ns/extract\n";
+    std::cout << "8-ary MinHeap:  " << eightTime * perExtract << " ns/extract\n";
+    std::cout << "checksum: " << checksum << std::endl;
+    return 0;
+}
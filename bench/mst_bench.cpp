@@ -0,0 +1,49 @@
+/*
+Minimum spanning tree benchmark.
+
+Builds a random graph (default 250000 vertices and 1M edges, weights in
+[1, 1000]) and computes its minimum spanning tree with filter-Kruskal and
+with parallel Boruvka. Both must report the same cost.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -pthread -Iinclude bench/mst_bench.cpp src/Graph.cpp src/DisjointSet.cpp src/ContractionHierarchy.cpp src/ThreadPool.cpp -o mst_bench
+    ./mst_bench [vertices] [edges]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "Graph.h"
+
+int main(int argc, char** argv) {
+    int vertices = argc > 1 ? std::atoi(argv[1]) : 250000;
+    int edgeCount = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    std::minstd_rand rng(1);
+    int (*edges)[3] = new int[edgeCount][3];
+    for (int i = 0; i < edgeCount; ++i) {
+        edges[i][0] = static_cast<int>(rng() % vertices);
+        edges[i][1] = static_cast<int>(rng() % vertices);
+        edges[i][2] = 1 + static_cast<int>(rng() % 1000);
+    }
+    Graph graph(vertices);
+    graph.buildGraph(edges, edgeCount);
+    delete[] edges;
+    std::cout << vertices << " vertices, " << edgeCount << " edges, " << std::thread::hardware_concurrency() << " threads\n";
+
+    const char* names[] = {"filter-Kruskal", "Boruvka"};
+    SpanningTreeMethod methods[] = {SpanningTreeMethod::Kruskal, SpanningTreeMethod::Boruvka};
+    for (int i = 0; i < 2; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Graph::Edge> tree = graph.spanningTreeEdges(methods[i]);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        long long cost = 0;
+        for (const Graph::Edge& edge : tree) {
+            cost += edge.first;
+        }
+        std::cout << names[i] << ": " << seconds * 1e3 << " ms, " << tree.size() << " tree edges, cost " << cost << "\n";
+    }
+    return 0;
+}
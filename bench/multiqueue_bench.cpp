@@ -0,0 +1,99 @@
+/*
+Scaling benchmark for MultiQueue.
+
+Every thread runs the "hold" model: pop an element, then push a slightly
+larger key. The same workload is run against a MinHeap behind one global
+mutex and against MinMultiQueue, for 1, 2, 4, ... up to the hardware thread
+count.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -pthread -Iinclude bench/multiqueue_bench.cpp -o multiqueue_bench
+    ./multiqueue_bench [operations per thread] [prefilled elements]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "MinHeap.h"
+#include "MultiQueue.h"
+
+// MinHeap serialized by a single mutex, the baseline being replaced
+class LockedHeap {
+private:
+    std::mutex lock;
+    MinHeap heap;
+
+public:
+    void push(int element) {
+        std::lock_guard<std::mutex> guard(lock);
+        heap.insert(element);
+    }
+
+    bool tryPop(int& element) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (heap.isEmpty()) {
+            return false;
+        }
+        element = heap.extract();
+        return true;
+    }
+};
+
+// Runs the hold model on threads threads and returns million operations per second
+template <typename Queue>
+double runHold(Queue& queue, int threads, int operations) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue, operations, t]() {
+            std::minstd_rand rng(t + 1);
+            for (int i = 0; i < operations; ++i) {
+                int key = 0;
+                if (queue.tryPop(key)) {
+                    queue.push(key + static_cast<int>(rng() % 1024));
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 2.0 * threads * operations / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int operations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int prefill = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    std::cout << "hold model, " << operations << " pop+push pairs per thread, " << prefill << " prefilled\n";
+    std::cout << "threads  locked MinHeap (Mops/s)  MinMultiQueue (Mops/s)\n";
+    for (int threads = 1;; threads *= 2) {
+        if (threads > maxThreads) {
+            threads = maxThreads;
+        }
+        std::minstd_rand rng(threads);
+        LockedHeap locked;
+        MinMultiQueue<int> multi(2 * threads);
+        for (int i = 0; i < prefill; ++i) {
+            int key = static_cast<int>(rng() % (1 << 24));
+            locked.push(key);
+            multi.push(key);
+        }
+        double lockedRate = runHold(locked, threads, operations);
+        double multiRate = runHold(multi, threads, operations);
+        std::cout << threads << "        " << lockedRate << "                  " << multiRate << "\n";
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+Read scaling of PersistentAVLTree under a concurrent writer.
+
+One writer thread keeps inserting and deleting random keys while 1, 2, 4,
+... reader threads look keys up for a fixed time. Readers of
+PersistentAVLTree take a Snapshot per batch of lookups and never block;
+the baseline is an AVLTree behind a std::shared_mutex, where every
+rotation excludes all readers.
+
+Build and run from the repository root:
+    g++ -std=c++17 -O2 -pthread -Iinclude bench/persistent_avl_bench.cpp src/AVLTree.cpp src/PersistentAVLTree.cpp -o persistent_avl_bench
+    ./persistent_avl_bench [keys] [milliseconds per run]
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "AVLTree.h"
+#include "PersistentAVLTree.h"
+
+// AVLTree with a reader/writer lock, the setup being replaced
+class LockedAVLTree {
+private:
+    mutable std::shared_mutex lock;
+    AVLTree tree;
+
+public:
+    void buildTree(int* elements, int size) { tree.buildTree(elements, size); }
+    void insert(int key) {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        tree.insert(key);
+    }
+    void deleteNode(int key) {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        tree.deleteNode(key);
+    }
+    int lookupBatch(const int* keys, int count) const {
+        int hits = 0;
+        for (int i = 0; i < count; ++i) {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            hits += tree.contains(keys[i]);
+        }
+        return hits;
+    }
+};
+
+// Lock-free readers over published versions
+class SnapshotReader {
+private:
+    PersistentAVLTree tree;
+
+public:
+    void buildTree(int* elements, int size) { tree.buildTree(elements, size); }
+    void insert(int key) { tree.insert(key); }
+    void deleteNode(int key) { tree.deleteNode(key); }
+    int lookupBatch(const int* keys, int count) const {
+        PersistentAVLTree::Snapshot snapshot = tree.snapshot();
+        int hits = 0;
+        for (int i = 0; i < count; ++i) {
+            hits += snapshot.contains(keys[i]);
+        }
+        return hits;
+    }
+};
+
+// Runs readers readers and one writer for the given time; returns million lookups per second
+template <typename Tree>
+double run(int keyCount, int readers, int milliseconds) {
+    Tree tree;
+    std::vector<int> keys(keyCount);
+    for (int i = 0; i < keyCount; ++i) {
+        keys[i] = 2 * i;
+    }
+    tree.buildTree(keys.data(), keyCount);
+
+    std::atomic<bool> stop(false);
+    std::atomic<long long> lookups(0);
+    std::atomic<long long> hitCount(0);
+    std::thread writer([&]() {
+        std::minstd_rand rng(99);
+        while (!stop.load(std::memory_order_relaxed)) {
+            int key = static_cast<int>(rng() % (2 * keyCount));
+            if (rng() & 1) {
+                tree.insert(key);
+            } else {
+                tree.deleteNode(key);
+            }
+        }
+    });
+
+    const int batch = 256;
+    std::vector<std::thread> workers;
+    for (int r = 0; r < readers; ++r) {
+        workers.emplace_back([&, r]() {
+            std::minstd_rand rng(r + 1);
+            std::vector<int> queries(batch);
+            long long done = 0;
+            long long hits = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int& query : queries) {
+                    query = static_cast<int>(rng() % (2 * keyCount));
+                }
+                hits += tree.lookupBatch(queries.data(), batch);
+                done += batch;
+            }
+            lookups += done;
+            hitCount += hits;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop = true;
+    writer.join();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return lookups.load() / (milliseconds / 1000.0) / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int keyCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int milliseconds = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int maxReaders = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    if (maxReaders < 1) {
+        maxReaders = 1;
+    }
+
+    std::cout << keyCount << " keys, one writer thread\n";
+    std::cout << "readers  shared_mutex AVLTree (M/s)  PersistentAVLTree (M/s)\n";
+    for (int readers = 1;; readers *= 2) {
+        if (readers > maxReaders) {
+            readers = maxReaders;
+        }
+        double locked = run<LockedAVLTree>(keyCount, readers, milliseconds);
+        double persistent = run<SnapshotReader>(keyCount, readers, milliseconds);
+        std::cout << readers << "        " << locked << "                    " << persistent << "\n";
+        if (readers == maxReaders) {
+            break;
+        }
+    }
+    return 0;
+}
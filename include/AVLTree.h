@@ -1,41 +1,164 @@
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
+#include <cstddef>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "EytzingerIndex.h"
+#include "NodeArena.h"
 
+struct AVLNode;
+typedef NodeArena<AVLNode>::Index AVLIndex;
+const AVLIndex AVL_NIL = NodeArena<AVLNode>::Nil;
+
+// Nodes live in the tree's arena and link to their children by 32-bit index,
+// which keeps a node at 20 bytes instead of 32 with two pointers. size counts
+// the keys in the node's subtree and drives the order-statistic queries.
 struct AVLNode {
     int key;
     int height;
-    AVLNode* left;
-    AVLNode* right;
-    AVLNode(int k) : key(k), height(1), left(nullptr), right(nullptr) {}
+    int size;
+    AVLIndex left;
+    AVLIndex right;
+    AVLNode() : key(0), height(0), size(0), left(AVL_NIL), right(AVL_NIL) {}
+    AVLNode(int k) : key(k), height(1), size(1), left(AVL_NIL), right(AVL_NIL) {}
 };
 
 class AVLTree {
 private:
-    AVLNode* root;
-
-    int height(AVLNode* node);
-    int getBalance(AVLNode* node);
-    AVLNode* rotateRight(AVLNode* y);
-    AVLNode* rotateLeft(AVLNode* x);
-    AVLNode* insert(AVLNode* node, int key);
-    void printAVLNode(AVLNode* node, std::ofstream& output);
+    NodeArena<AVLNode> nodes;
+    AVLIndex root;
+    EytzingerIndex frozen;
+
+    int height(AVLIndex node);
+    int getBalance(AVLIndex node);
+    void update(AVLIndex node);
+    AVLIndex rotateRight(AVLIndex y);
+    AVLIndex rotateLeft(AVLIndex x);
+    AVLIndex insert(AVLIndex node, int key);
+    void printAVLNode(AVLIndex node, std::ofstream& output);
     int max(int a, int b) const;
-    int size(AVLNode* node) const;
-    AVLNode* findMinNode(AVLNode* node) const;
-    AVLNode* searchNode(AVLNode* node, int key) const;
-    AVLNode* deleteNode(AVLNode* node, int key);
+    int size(AVLIndex node) const;
+    AVLIndex findMinNode(AVLIndex node) const;
+    AVLIndex searchNode(AVLIndex node, int key) const;
+    AVLIndex deleteNode(AVLIndex node, int key);
+    AVLIndex rebalance(AVLIndex node);
+    AVLIndex findMaxNode(AVLIndex node) const;
+    AVLIndex joinNodes(AVLIndex l, AVLIndex mid, AVLIndex r);
+    AVLIndex detachMin(AVLIndex node, AVLIndex& minNode);
+    AVLIndex concat(AVLIndex l, AVLIndex r);
+    void splitNode(AVLIndex node, int key, AVLIndex& less, AVLIndex& notLess);
+    AVLIndex buildSorted(const int* keys, int count);
+    void collectKeys(AVLIndex node, std::vector<int>& keys) const;
+    void releaseSubtree(AVLIndex node);
+    void thaw();
+    static AVLIndex copyPreorder(const NodeArena<AVLNode>& source, AVLIndex node, NodeArena<AVLNode>& target);
+    int countLess(int key, bool inclusive) const;
 
 public:
+    // Bidirectional in-order iterator. It keeps the root-to-node path in a
+    // fixed array (an AVL tree over 32-bit indices is never deeper than 48),
+    // so it needs no parent links and never allocates. Any insert or delete
+    // invalidates outstanding iterators.
+    class Iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef int value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const int* pointer;
+        typedef const int& reference;
+
+        Iterator() : tree(nullptr), depth(0) {}
+        reference operator*() const { return tree->nodes[path[depth - 1]].key; }
+        pointer operator->() const { return &**this; }
+        Iterator& operator++();
+        Iterator& operator--();
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+        bool operator==(const Iterator& other) const {
+            return depth == other.depth && (depth == 0 || path[depth - 1] == other.path[other.depth - 1]);
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class AVLTree;
+        static const int MaxDepth = 48;
+
+        const AVLTree* tree;
+        AVLIndex path[MaxDepth];
+        int depth;
+
+        explicit Iterator(const AVLTree* tree) : tree(tree), depth(0) {}
+        void push(AVLIndex node) { path[depth++] = node; }
+        void descend(AVLIndex node, bool leftmost);
+    };
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+
     AVLTree();
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+    AVLTree(AVLTree&& other) noexcept;
+    AVLTree& operator=(AVLTree&& other) noexcept;
     void insert(int key);
     void buildTree(int* elements, int size);
+    void clear();
+    void join(AVLTree& other);
+    AVLTree split(int key);
+    void compact();
+    void freeze();
+    bool isFrozen() const;
     int getSize() const;
     int findMin() const;
+    int rank(int key) const;
+    int select(int k) const;
+    int countInRange(int lo, int hi) const;
+    int median() const;
+    Iterator begin() const;
+    Iterator end() const;
+    Iterator lower_bound(int key) const;
+    Iterator upper_bound(int key) const;
+    template <typename Function>
+    void forEachInRange(int lo, int hi, Function fn) const;
+    bool contains(int key) const;
     std::string search(int key) const;
     void deleteNode(int key);
     void printAVLTree(std::ofstream& output);
 };
 
+// Calls fn(key) for every key in [lo, hi] in ascending order. Only the
+// O(log n) path to lo plus the k reported nodes are visited, using an
+// explicit stack; the next node on the stack is prefetched while fn runs.
+template <typename Function>
+void AVLTree::forEachInRange(int lo, int hi, Function fn) const {
+    AVLIndex stack[Iterator::MaxDepth];
+    int depth = 0;
+    AVLIndex node = root;
+    while (node != AVL_NIL) {
+        if (nodes[node].key < lo) {
+            node = nodes[node].right;
+        } else {
+            stack[depth++] = node;
+            node = nodes[node].left;
+        }
+    }
+
+    while (depth > 0) {
+        node = stack[--depth];
+        const AVLNode& current = nodes[node];
+        if (current.key > hi) {
+            return;
+        }
+        for (AVLIndex next = current.right; next != AVL_NIL; next = nodes[next].left) {
+            stack[depth++] = next;
+        }
+        if (depth > 0) {
+            __builtin_prefetch(&nodes[stack[depth - 1]]);
+        }
+        fn(current.key);
+    }
+}
+
 #endif // AVLTREE_H
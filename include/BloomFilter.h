@@ -0,0 +1,36 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Blocked Bloom filter over 64-bit hashes. Each key sets k bits inside one
+// 64-byte block chosen by its hash, so a lookup reads a single cache line.
+// mayContain never returns false for an added key; it returns true for an
+// absent key with roughly the configured false-positive rate. Keys cannot be
+// removed: the owner rebuilds the filter to drop them.
+class BloomFilter {
+public:
+    BloomFilter();
+
+    void reset(std::size_t expectedKeys, double falsePositiveRate, std::size_t maxBytes = 0);
+    void clear();
+    void add(uint64_t hash);
+    bool mayContain(uint64_t hash) const;
+    void prefetch(uint64_t hash) const;
+    bool isEmpty() const { return blocks.empty(); }
+    std::size_t bytes() const { return blocks.size() * sizeof(Block); }
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    std::vector<Block> blocks;
+    int probes;
+
+    std::size_t blockIndex(uint64_t hash) const;
+};
+
+#endif // BLOOMFILTER_H
@@ -0,0 +1,84 @@
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "SwissGroup.h"
+
+// Hash set of ints that many threads can use at once. Keys are split over
+// shards by hash; each shard is an open-addressing table laid out like
+// HashTable. Writers lock only their shard. Readers take no lock: they read
+// the shard under a sequence counter (seqlock) that writers make odd while
+// they modify it, and retry if it changed during the read. Arrays replaced
+// by a shard rehash are retired and freed with epoch-based reclamation, as in
+// PersistentAVLTree: each lookup announces the epoch it started in, and an
+// array is freed once every announced epoch is newer than its retirement, so
+// a reader that raced a rehash still reads valid memory.
+class ConcurrentHashTable {
+public:
+    explicit ConcurrentHashTable(int size = 0, int shardCount = 64);
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    bool insert(int key);
+    bool erase(int key);
+    bool contains(int key) const;
+    int getSize() const;
+
+private:
+    static const int GroupSize = swissGroupSize;
+
+    // Control bytes are read as 8-byte words so readers racing a writer
+    // perform atomic loads rather than plain ones
+    struct Arrays {
+        int capacity;
+        std::unique_ptr<std::atomic<uint64_t>[]> control;
+        std::unique_ptr<std::atomic<int>[]> slots;
+        explicit Arrays(int capacity);
+    };
+
+    struct RetiredArrays {
+        uint64_t epoch;
+        std::unique_ptr<Arrays> arrays;
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<uint32_t> sequence;
+        std::atomic<Arrays*> arrays;
+        std::atomic<int> count;
+        int growthLeft;
+        std::mutex lock;
+        std::unique_ptr<Arrays> live;
+        std::deque<RetiredArrays> retired;
+        Shard() : sequence(0), arrays(nullptr), count(0), growthLeft(0) {}
+    };
+
+    static const int MaxReaders = 128;
+
+    // Reader announcement: the epoch a lookup started in, or 0 when the slot is free
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch;
+        ReaderSlot() : epoch(0) {}
+    };
+
+    int shardBits;
+    std::unique_ptr<Shard[]> shards;
+    std::atomic<uint64_t> globalEpoch;
+    mutable ReaderSlot readers[MaxReaders];
+
+    Shard& shardFor(uint64_t hash) const;
+    static void loadGroup(const Arrays& arrays, uint64_t group, int8_t* bytes);
+    static void storeControl(Arrays& arrays, int slot, int8_t value);
+    static int findSlot(const Arrays& arrays, int key, uint64_t hash, bool& complete);
+    static int freeSlot(const Arrays& arrays, uint64_t hash);
+    void rehash(Shard& shard, int newCapacity);
+    void reclaim(Shard& shard);
+    int enterRead() const;
+    void exitRead(int slot) const;
+};
+
+#endif // CONCURRENTHASHTABLE_H
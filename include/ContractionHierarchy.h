@@ -0,0 +1,52 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <vector>
+
+// Contraction hierarchy over an undirected weighted graph. Preprocessing
+// removes ("contracts") vertices one at a time, least important first, and
+// adds a shortcut edge between two neighbors of the removed vertex whenever
+// the path through it was their only shortest connection. Every vertex then
+// keeps only its edges to vertices contracted later (its upward edges). A
+// query runs Dijkstra upward from both endpoints and meets at the most
+// important vertex of the shortest path, which settles only a few hundred
+// vertices even on large road networks. Shortcuts remember the vertex they
+// bypass, so the full path can be unpacked.
+class ContractionHierarchy {
+public:
+    ContractionHierarchy();
+
+    void build(int vertices, const int* offsets, const int* neighbors, const int* weights);
+    void clear();
+    bool isBuilt() const { return built; }
+    int getShortcutCount() const { return shortcutCount; }
+
+    int distance(int source, int destination);
+    std::vector<int> path(int source, int destination);
+
+private:
+    // Edge to a more important vertex; middle is the bypassed vertex of a
+    // shortcut, or -1 for an original edge
+    struct Arc {
+        int to;
+        int weight;
+        int middle;
+    };
+
+    int shortcutCount;
+    bool built;
+    std::vector<int> upOffsets;
+    std::vector<Arc> upArcs;
+
+    // Query state, reset by bumping stamp instead of refilling
+    std::vector<int> dist[2];
+    std::vector<int> parentArc[2];
+    std::vector<unsigned> seen[2];
+    unsigned stamp;
+
+    int search(int source, int destination, int& meet);
+    const Arc& arcBetween(int from, int to) const;
+    void unpack(int from, const Arc& arc, std::vector<int>& route) const;
+};
+
+#endif // CONTRACTIONHIERARCHY_H
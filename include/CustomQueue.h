@@ -1,50 +1,49 @@
 #ifndef CUSTOMQUEUE_H
 #define CUSTOMQUEUE_H
 
-#include <vector>
-#include <functional> // for std::greater
-
-template <typename T>
+#include <functional> // for std::less
+#include "Heap.h"
+
+// Priority queue used by Dijkstra's algorithm: front() is the element that
+// comes first under Compare (the smallest with the default std::less). It is
+// a 4-ary Heap underneath, so push and pop take O(log n) instead of the
+// element shifts of a sorted vector.
+template <typename T, typename Compare = std::less<T>>
 class CustomQueue {
 private:
-    std::vector<T> elements;
+    Heap<T, Compare, 4> elements;
 
 public:
-    // Custom implementation of lower_bound for maintaining sorted order
-    template<typename ForwardIt, typename Compare>
-    ForwardIt custom_lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
-    while (first != last) {
-        auto mid = std::next(first, std::distance(first, last) / 2);
-        if (comp(*mid, value)) {
-            first = ++mid;
-        } else {
-            last = mid;
-        }
-    }
-    return first;
-}
-
-    // Pushes an element into the queue while maintaining order
+    // Pushes an element into the queue
     void push(const T& element) {
-        auto it = custom_lower_bound(elements.begin(), elements.end(), element, std::greater<T>());
-        elements.insert(it, element);
+        elements.insert(element);
     }
 
     // Removes the front element from the queue
     void pop() {
         if (!isEmpty()) {
-            elements.erase(elements.begin());
+            elements.extract();
         }
     }
 
+    // Removes every element, keeping the storage for reuse
+    void clear() {
+        elements.buildHeap(nullptr, 0);
+    }
+
     // Returns the front element
-    T& front() {
-        return elements.front();
+    const T& front() const {
+        return elements.top();
     }
 
     // Checks if the queue is empty
     bool isEmpty() const {
-        return elements.empty();
+        return elements.isEmpty();
+    }
+
+    // Returns the number of queued elements
+    int size() const {
+        return elements.getSize();
     }
 };
 
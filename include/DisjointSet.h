@@ -1,28 +1,40 @@
 #ifndef DISJOINTSET_H
 #define DISJOINTSET_H
 
+#include <utility>
 #include <vector>
-// This class is used for finding the spanning tree of a graph
+// This class is used for finding the spanning tree of a graph. Sets are
+// merged by size and find halves the path it walks, so any sequence of
+// operations runs in near-constant amortized time per operation.
 class DisjointSet {
 private:
-    std::vector<int> parent; // Stores the parent of each element
+    std::vector<int> parent; // Parent of each element, or minus the set size for a representative
 
 public:
     DisjointSet(int n) : parent(n, -1) {}
 
     // Finds the representative of the set containing element i
     int find(int i) {
-        if (parent[i] == -1)
-            return i;
-        return find(parent[i]);
+        while (parent[i] >= 0) {
+            if (parent[parent[i]] >= 0) {
+                parent[i] = parent[parent[i]];
+            }
+            i = parent[i];
+        }
+        return i;
     }
 
-    // Unites the sets containing elements x and y
-    void unionSet(int x, int y) {
+    // Unites the sets containing elements x and y; returns false if they were already one set
+    bool unionSet(int x, int y) {
         int xset = find(x);
         int yset = find(y);
-        if (xset != yset)
-            parent[xset] = yset;
+        if (xset == yset)
+            return false;
+        if (parent[xset] > parent[yset])
+            std::swap(xset, yset);
+        parent[xset] += parent[yset];
+        parent[yset] = xset;
+        return true;
     }
 };
 
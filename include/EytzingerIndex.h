@@ -0,0 +1,68 @@
+#ifndef EYTZINGERINDEX_H
+#define EYTZINGERINDEX_H
+
+#include <cstddef>
+#include <new>
+
+// Static sorted-key index in Eytzinger (BFS) order: the children of slot k
+// are 2k and 2k + 1, so a search walks one implicit tree with a branch-free
+// step per level. Slot 0 is unused and the array is 64-byte aligned, which
+// puts the 16 descendants four levels below any slot in a single cache line;
+// the search prefetches that line while the next comparisons run.
+class EytzingerIndex {
+private:
+    static const std::size_t CacheLine = 64;
+
+    int* slots;
+    std::size_t count;
+
+    // Stores sorted[next...] into the subtree rooted at slot k in in-order sequence
+    void fill(const int* sorted, std::size_t& next, std::size_t k) {
+        if (k <= count) {
+            fill(sorted, next, 2 * k);
+            slots[k] = sorted[next++];
+            fill(sorted, next, 2 * k + 1);
+        }
+    }
+
+public:
+    EytzingerIndex() : slots(nullptr), count(0) {}
+    ~EytzingerIndex() { clear(); }
+    EytzingerIndex(const EytzingerIndex&) = delete;
+    EytzingerIndex& operator=(const EytzingerIndex&) = delete;
+
+    // Lays out count keys given in ascending order
+    void build(const int* sorted, std::size_t count) {
+        clear();
+        this->count = count;
+        slots = static_cast<int*>(::operator new((count + 1) * sizeof(int), std::align_val_t(CacheLine)));
+        std::size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    // Frees the index
+    void clear() {
+        if (slots) {
+            ::operator delete(slots, std::align_val_t(CacheLine));
+        }
+        slots = nullptr;
+        count = 0;
+    }
+
+    bool isBuilt() const { return slots != nullptr; }
+    std::size_t size() const { return count; }
+
+    // Checks if key is in the index
+    bool contains(int key) const {
+        std::size_t k = 1;
+        while (k <= count) {
+            __builtin_prefetch(reinterpret_cast<const char*>(slots) + 16 * k * sizeof(int));
+            k = 2 * k + (slots[k] < key);
+        }
+        // Undo the trailing right turns plus one left turn to reach the lower bound
+        k >>= __builtin_ffsll(~static_cast<long long>(k));
+        return k != 0 && slots[k] == key;
+    }
+};
+
+#endif // EYTZINGERINDEX_H
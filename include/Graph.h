@@ -3,18 +3,74 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 
 #include <fstream>
+#include "ContractionHierarchy.h"
+#include "DisjointSet.h"
+#include "ThreadPool.h"
+
+// Single-source shortest-path engine for Graph::computeDistances
+enum class ShortestPathMethod {
+    Dijkstra,      // sequential, settles vertices one at a time
+    DeltaStepping  // parallel, settles a whole distance bucket per step
+};
+
+// Minimum spanning tree engine for Graph::computeSpanningTree
+enum class SpanningTreeMethod {
+    Kruskal,  // filter-Kruskal, sequential
+    Boruvka   // parallel rounds of cheapest edges between components
+};
+
 class Graph {
+public:
+    typedef std::pair<int, std::pair<int, int>> Edge;  // (weight, (u, v))
+
 private:
+    // Contiguous copy of adjList for the read-only algorithms: the neighbors
+    // of v are neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1], with
+    // matching weights. Built on first use and dropped by any edge change.
+    struct Snapshot {
+        std::vector<int> offsets;
+        std::vector<int> neighbors;
+        std::vector<int> weights;
+        int maxWeight = 0;
+        bool valid = false;
+    };
+
+    // Per-worker scratch for batched searches. An entry of dist is valid only
+    // where seen matches stamp, so a new search bumps stamp instead of
+    // refilling the arrays; target marks the destinations still wanted.
+    struct Workspace {
+        std::vector<int> dist;
+        std::vector<unsigned> seen;
+        std::vector<unsigned> target;
+        unsigned stamp = 0;
+    };
+
     int vertices;
+    int edgeCount;
     std::vector<std::list<std::pair<int, int>>> adjList;
+    Snapshot csr;
+    ContractionHierarchy hierarchy;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<Workspace> workspaces;
+
+    const Snapshot& snapshot();
+    void invalidate();
 
-    std::vector<int> dijkstraShortestPath(int source);
+    std::vector<int> dijkstraShortestPath(int source, int destination = -1, std::vector<int>* parents = nullptr);
+    std::vector<int> deltaSteppingShortestPath(int source);
+    ThreadPool& threads();
+    void searchFrom(const Snapshot& graph, Workspace& space, int source, const std::pair<int, int>* queries,
+                    const int* indices, int count, int* results) const;
     void dfs(int v, std::vector<bool>& visited);
     int find(int parent[], int i);
     void unionSet(int parent[], int x, int y);
-    int kruskalMST();
+    std::vector<Edge> undirectedEdges();
+    void filterKruskal(std::vector<Edge>& edges, size_t begin, size_t end, DisjointSet& forest, std::vector<Edge>& tree);
+    std::vector<Edge> kruskalMST();
+    std::vector<Edge> boruvkaMST();
 
 public:
     Graph(int V);
@@ -22,8 +78,14 @@ public:
     void resize(size_t newSize);
     void buildGraph(int edges[][3], int size);
     std::pair<int, int> getSize() const;
+    void buildHierarchy();
+    bool hasHierarchy() const;
     int computeShortestPath(int source, int destination);
-    int computeSpanningTree();
+    std::vector<int> computeShortestPaths(const std::vector<std::pair<int, int>>& queries);
+    std::vector<int> computeDistances(int source, ShortestPathMethod method = ShortestPathMethod::Dijkstra);
+    std::vector<int> computePath(int source, int destination);
+    int computeSpanningTree(SpanningTreeMethod method = SpanningTreeMethod::Kruskal);
+    std::vector<Edge> spanningTreeEdges(SpanningTreeMethod method = SpanningTreeMethod::Kruskal);
     int findConnectedComponents();
     bool insertEdge(int source, int destination, int weight);
     bool deleteEdge(int source, int destination);
@@ -1,24 +1,135 @@
 #ifndef HASHTABLE_H
 #define HASHTABLE_H
 
-#include <list>
-#include <vector>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "BloomFilter.h"
+#include "PerfectHashIndex.h"
+#include "RoaringSet.h"
+#include "SwissGroup.h"
 
+// Open-addressing hash set in the style of Swiss tables. Keys are stored
+// inline in a slot array; a parallel array of one control byte per slot
+// holds either a marker (empty / deleted) or 7 bits of the key's hash. A
+// lookup scans a whole 16-slot group of control bytes with one SIMD compare
+// and only touches the slots whose hash bits match.
+//
+// The table grows at 7/8 load by allocating one twice as large and moving
+// keys over incrementally: every insert, erase and search migrates a few
+// groups, and until the old table is drained lookups check both. No single
+// operation pays for a full rehash.
+//
+// An optional blocked Bloom filter answers most lookups of absent keys from
+// one cache line without probing the table. Erased keys stay in the filter
+// until the next rehash rebuilds it.
+//
+// When buildTable fills an empty table with a dense range of keys (at least
+// one key per DenseSpanPerKey values), the keys go into a RoaringSet instead
+// of the slot array, taking about a bit per key; the table stays in that
+// mode for its lifetime, the set adapting its containers as keys change.
+//
+// freeze() moves the keys into a PerfectHashIndex for tables that are only
+// queried from then on: one probe per lookup and about 3.5 bits per key on
+// top of the keys. The frozen index can be saved to and loaded from a file.
+// Any change thaws the table back into its mutable form first.
 class HashTable {
 private:
-    int capacity;
-    std::vector<std::list<int>> table;
+    static const int GroupSize = swissGroupSize;
+    static const int MigrateGroups = 2;
+    static const int BatchWidth = 16;
+    static const int DenseMinKeys = 1024;
+    static const int DenseSpanPerKey = 8;
 
-    int hashFunction(int key);
+    struct Table {
+        int capacity;      // slots, a power of two and a multiple of GroupSize
+        int count;         // keys stored
+        int growthLeft;    // inserts into empty slots allowed before the next rehash
+        int8_t* control;
+        int* slots;
+    };
+
+    Table current;
+    Table draining;        // previous table while its keys are being moved; capacity 0 otherwise
+    int migrateCursor;     // next slot of draining to move
+
+    BloomFilter filter;        // covers every key while filterRate > 0
+    BloomFilter nextFilter;    // built for current during a rehash, replaces filter when it ends
+    double filterRate;         // target false-positive rate, 0 when the filter is off
+    std::size_t filterBudget;  // byte limit for the filter, 0 for none
+    mutable uint64_t filterRejects;
+    mutable uint64_t filterPasses;
+    mutable uint64_t filterFalsePositives;
+
+    bool dense;                // keys live in denseKeys rather than the slot arrays
+    RoaringSet denseKeys;
+
+    PerfectHashIndex frozen;   // holds every key while the table is frozen
+
+    static uint64_t hashFunction(int key);
+    static void allocate(Table& table, int capacity);
+    static void release(Table& table);
+    static int findSlot(const Table& table, int key, uint64_t hash);
+    static void prefetchGroup(const Table& table, uint64_t hash);
+    static void insertNew(Table& table, int key, uint64_t hash);
+    static void eraseSlot(Table& table, int slot);
+    static int capacityFor(int keys);
+    void startRehash(int newCapacity);
+    void migrate(int groups);
+    void finishRehash();
+    void resetFilter(BloomFilter& target, int capacity) const;
+    bool lookup(int key, uint64_t hash) const;
+    static bool isDenseRange(const int* elements, int size);
+    void thaw();
+    void clearKeys();
+
+    template <typename Visitor>
+    void forEachKey(Visitor visit) const;
 
 public:
     HashTable(int size);
+    ~HashTable();
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
     void insert(int key);
+    bool erase(int key);
     void buildTable(int* elements, int size);
     void printTable(std::ofstream& output);
     int getSize() const;
+    int getCapacity() const;
+    bool contains(int key) const;
     std::string search(int key);
+    void searchBatch(const int* keys, std::size_t n, uint8_t* found);
+    bool isDense() const;
+    void freeze();
+    bool isFrozen() const;
+    bool save(const std::string& filename);
+    bool load(const std::string& filename);
+    void unionWith(const HashTable& other);
+    void intersectWith(const HashTable& other);
+    void enableFilter(double falsePositiveRate, std::size_t maxBytes = 0);
+    void disableFilter();
+    std::size_t getFilterBytes() const;
+    uint64_t getFilterRejects() const;
+    uint64_t getFilterPasses() const;
+    uint64_t getFilterFalsePositives() const;
 };
 
+// Calls visit(key) for every key, in no particular order
+template <typename Visitor>
+void HashTable::forEachKey(Visitor visit) const {
+    for (const Table* table : {&current, &draining}) {
+        for (int i = 0; i < table->capacity; ++i) {
+            if (table->control[i] >= 0) {
+                visit(table->slots[i]);
+            }
+        }
+    }
+    denseKeys.forEach(visit);
+    for (std::size_t i = 0; i < frozen.size(); ++i) {
+        visit(frozen.data()[i]);
+    }
+}
+
 #endif // HASHTABLE_H
@@ -2,24 +2,314 @@
 #define HEAP_H
 #include <fstream>
 #include <string>
-#include "CustomAlgorithm.h"
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include "HeapChildSelector.h"
 
+// d-ary heap ordered by Compare: compare(a, b) is true when a belongs above b.
+// The comparator is a template parameter, so stateless comparators such as
+// std::less are inlined into the sift loops instead of being called through a
+// pointer. A function pointer type still works as Compare when a runtime
+// comparator is really needed.
+//
+// Children of index i live at Arity * i + 1 ... Arity * i + Arity. The storage
+// is 64-byte aligned and shifted by Arity - 1 slots so that every sibling group
+// starts on a multiple of Arity elements; with 4-ary or 8-ary int heaps a
+// group never straddles a cache line and is picked with one SIMD compare.
+template <typename Key, typename Compare = std::less<Key>, int Arity = 2>
 class Heap {
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
 protected:
-    int* data;
+    static const int CacheLine = 64;
+
+    Key* storage;
+    Key* data;
     int capacity;
     int size;
-    virtual void reheapDown(int index, bool (*compare)(int, int)) = 0;
-    virtual void reheapUp(int index, bool (*compare)(int, int)) = 0;
+    Compare comp;
+
+    void reheapDown(int index);
+    void reheapUp(int index);
+    void reserve(int newCapacity);
+    void release();
 
 public:
-    Heap();
-    virtual ~Heap();
-    void buildHeap(int* elements, int size, bool (*compare)(int, int));
+    explicit Heap(Compare comp = Compare());
+    ~Heap();
+    Heap(const Heap&) = delete;
+    Heap& operator=(const Heap&) = delete;
+
+    void buildHeap(const Key* elements, int size);
     int getSize() const;
-    virtual void insert(int element, bool (*compare)(int, int));
-    virtual int extract(bool (*compare)(int, int));
+    bool isEmpty() const;
+    void insert(const Key& element);
+    void insertBatch(const Key* elements, int count);
+    Key extract();
+    int extractTopK(int k, Key* out);
+    const Key& top() const;
     void printHeap(std::string heaptype, std::ofstream& output);
+
+    // The heap's ordering, as a plain function
+    static bool compare(Key a, Key b) { return Compare()(a, b); }
+};
+
+// Constructor to initialize an empty heap
+template <typename Key, typename Compare, int Arity>
+Heap<Key, Compare, Arity>::Heap(Compare comp)
+    : storage(nullptr), data(nullptr), capacity(0), size(0), comp(comp) {}
+
+// Destructor to deallocate memory
+template <typename Key, typename Compare, int Arity>
+Heap<Key, Compare, Arity>::~Heap() {
+    release();
+}
+
+// Destroys the elements and frees the aligned storage
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::release() {
+    if (!storage) {
+        return;
+    }
+    for (int i = 0; i < capacity + Arity - 1; ++i) {
+        storage[i].~Key();
+    }
+    ::operator delete(storage, std::align_val_t(CacheLine));
+    storage = nullptr;
+    data = nullptr;
+}
+
+// Grows the storage to hold at least newCapacity elements
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::reserve(int newCapacity) {
+    if (newCapacity <= capacity) {
+        return;
+    }
+    int slots = newCapacity + Arity - 1;
+    Key* newStorage = static_cast<Key*>(::operator new(slots * sizeof(Key), std::align_val_t(CacheLine)));
+    for (int i = 0; i < slots; ++i) {
+        new (newStorage + i) Key();
+    }
+    Key* newData = newStorage + (Arity - 1);
+    for (int i = 0; i < size; ++i) {
+        newData[i] = std::move(data[i]);
+    }
+    release();
+    storage = newStorage;
+    data = newData;
+    capacity = newCapacity;
+}
+
+// Performs a downward heapification starting from the given index.
+// The displaced element is held aside and the hole moves down one level per
+// iteration, so each level costs one move instead of a swap.
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::reheapDown(int index) {
+    Key value = std::move(data[index]);
+    while (true) {
+        int first = Arity * index + 1;
+        if (first >= size) {
+            break;
+        }
+        int count = size - first < Arity ? size - first : Arity;
+        int best = first + HeapChildSelector<Key, Compare, Arity>::select(data + first, count, comp);
+        if (!comp(data[best], value)) {
+            break;
+        }
+        data[index] = std::move(data[best]);
+        index = best;
+    }
+    data[index] = std::move(value);
+}
+
+// Performs an upward heapification starting from the given index
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::reheapUp(int index) {
+    Key value = std::move(data[index]);
+    while (index) {
+        int parent = (index - 1) / Arity;
+        if (!comp(value, data[parent])) {
+            break;
+        }
+        data[index] = std::move(data[parent]);
+        index = parent;
+    }
+    data[index] = std::move(value);
+}
+
+// Builds a heap from an array of elements
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::buildHeap(const Key* elements, int size) {
+    this->size = 0;
+    reserve(size);
+    this->size = size;
+
+    for (int i = 0; i < size; ++i) {
+        data[i] = elements[i];
+    }
+
+    // Floyd's method: sift down every internal node, last parent first
+    for (int i = size > 1 ? (size - 2) / Arity : -1; i >= 0; --i) {
+        reheapDown(i);
+    }
+}
+
+// Returns the size of the heap
+template <typename Key, typename Compare, int Arity>
+int Heap<Key, Compare, Arity>::getSize() const {
+    return size;
+}
+
+// Checks if the heap is empty
+template <typename Key, typename Compare, int Arity>
+bool Heap<Key, Compare, Arity>::isEmpty() const {
+    return size == 0;
+}
+
+// Inserts an element into the heap
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::insert(const Key& element) {
+    if (size >= capacity) {
+        reserve(capacity == 0 ? 1 : capacity * 2);
+    }
+
+    data[size++] = element;
+    reheapUp(size - 1);
+}
+
+// Inserts count elements with a single capacity check. Small batches are
+// sifted up one by one; once the batch is at least as large as the heap it
+// joins, a Floyd rebuild of the whole array (at most 2 compares per element)
+// is cheaper than count sift-ups of up to log n compares each.
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::insertBatch(const Key* elements, int count) {
+    if (count <= 0) {
+        return;
+    }
+    if (size + count > capacity) {
+        int newCapacity = capacity == 0 ? 1 : capacity;
+        while (newCapacity < size + count) {
+            newCapacity *= 2;
+        }
+        reserve(newCapacity);
+    }
+
+    bool rebuild = count >= size;
+    for (int i = 0; i < count; ++i) {
+        data[size++] = elements[i];
+        if (!rebuild) {
+            reheapUp(size - 1);
+        }
+    }
+    if (rebuild) {
+        for (int i = size > 1 ? (size - 2) / Arity : -1; i >= 0; --i) {
+            reheapDown(i);
+        }
+    }
+}
+
+// Removes and returns the root element of the heap
+template <typename Key, typename Compare, int Arity>
+Key Heap<Key, Compare, Arity>::extract() {
+    if (size == 0) {
+        throw std::runtime_error("Heap is empty");
+    }
+
+    Key root = std::move(data[0]);
+    data[0] = std::move(data[--size]);
+    if (size > 0) {
+        reheapDown(0);
+    }
+    return root;
+}
+
+// Removes the k best elements and writes them to out in heap order; returns
+// how many were written. The winners are found by walking a small frontier
+// heap over slot indices (O(k log k)), so the main heap is not sifted k times.
+// The removed slots form a subtree at the root; each hole that is still inside
+// the shrunken heap is refilled from the cut-off tail and sifted down, deepest
+// hole first, exactly like a Floyd rebuild restricted to those slots.
+template <typename Key, typename Compare, int Arity>
+int Heap<Key, Compare, Arity>::extractTopK(int k, Key* out) {
+    if (k > size) {
+        k = size;
+    }
+    if (k <= 0) {
+        return 0;
+    }
+
+    struct SlotCompare {
+        const Key* data;
+        Compare comp;
+        bool operator()(int a, int b) const { return comp(data[a], data[b]); }
+    };
+    Heap<int, SlotCompare, Arity> frontier(SlotCompare{data, comp});
+    std::vector<int> removed;
+    removed.reserve(k);
+    frontier.insert(0);
+    for (int i = 0; i < k; ++i) {
+        int slot = frontier.extract();
+        out[i] = data[slot];
+        removed.push_back(slot);
+        int first = Arity * slot + 1;
+        for (int child = first; child < first + Arity && child < size; ++child) {
+            frontier.insert(child);
+        }
+    }
+
+    int newSize = size - k;
+    std::sort(removed.begin(), removed.end());
+    std::vector<int> movers;
+    std::vector<int>::const_iterator cut = std::lower_bound(removed.begin(), removed.end(), newSize);
+    std::vector<int>::const_iterator next = cut;
+    for (int slot = newSize; slot < size; ++slot) {
+        if (next != removed.end() && *next == slot) {
+            ++next;
+        } else {
+            movers.push_back(slot);
+        }
+    }
+
+    size = newSize;
+    std::vector<int>::const_iterator hole = cut;
+    for (std::size_t i = 0; i < movers.size(); ++i) {
+        --hole;
+        data[*hole] = std::move(data[movers[i]]);
+        reheapDown(*hole);
+    }
+    return k;
+}
+
+// Returns the root element of the heap
+template <typename Key, typename Compare, int Arity>
+const Key& Heap<Key, Compare, Arity>::top() const {
+    if (size == 0) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return data[0];
+}
+
+// Prints the heap to a file
+template <typename Key, typename Compare, int Arity>
+void Heap<Key, Compare, Arity>::printHeap(std::string heaptype, std::ofstream& output) {
+    output << heaptype;
+    for (int i = 0; i < size; ++i) {
+        output << data[i] << " ";
+    }
+    output << std::endl;
+}
+
+// Orders key/payload pairs by their key only, so payloads need no operator<
+template <typename KeyCompare>
+struct CompareByKey {
+    template <typename Pair>
+    bool operator()(const Pair& a, const Pair& b) const {
+        return KeyCompare()(a.first, b.first);
+    }
 };
 
 #endif // HEAP_H
@@ -0,0 +1,87 @@
+#ifndef HEAPCHILDSELECTOR_H
+#define HEAPCHILDSELECTOR_H
+
+#include <functional>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Picks the child that belongs highest among count consecutive siblings and
+// returns its offset. Ties go to the leftmost child.
+template <typename Key, typename Compare, int Arity>
+struct HeapChildSelector {
+    static int select(const Key* children, int count, const Compare& comp) {
+        int best = 0;
+        for (int i = 1; i < count; ++i) {
+            if (comp(children[i], children[best])) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+#if defined(__SSE2__)
+// Keeps, lane by lane, the smaller (or larger) of a and b
+template <bool Smallest>
+inline __m128i heapPickLanes(__m128i a, __m128i b) {
+    __m128i takeA = Smallest ? _mm_cmplt_epi32(a, b) : _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(takeA, a), _mm_andnot_si128(takeA, b));
+}
+
+// Selects the best of a full, 16-byte aligned group of Arity ints
+template <bool Smallest, int Arity>
+inline int heapSelectIntGroup(const int* children) {
+    const __m128i* lanes = reinterpret_cast<const __m128i*>(children);
+    __m128i best = _mm_load_si128(lanes);
+    for (int i = 1; i < Arity / 4; ++i) {
+        best = heapPickLanes<Smallest>(best, _mm_load_si128(lanes + i));
+    }
+    best = heapPickLanes<Smallest>(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+    best = heapPickLanes<Smallest>(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+
+    int mask = 0;
+    for (int i = 0; i < Arity / 4; ++i) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_load_si128(lanes + i), best);
+        mask |= _mm_movemask_ps(_mm_castsi128_ps(equal)) << (4 * i);
+    }
+    return __builtin_ctz(mask);
+}
+
+// int min heaps with a multiple-of-4 arity compare whole sibling groups at once
+template <int Arity>
+struct HeapChildSelector<int, std::less<int>, Arity> {
+    static int select(const int* children, int count, const std::less<int>& comp) {
+        if (Arity % 4 == 0 && count == Arity) {
+            return heapSelectIntGroup<true, Arity>(children);
+        }
+        int best = 0;
+        for (int i = 1; i < count; ++i) {
+            if (comp(children[i], children[best])) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+// int max heaps with a multiple-of-4 arity compare whole sibling groups at once
+template <int Arity>
+struct HeapChildSelector<int, std::greater<int>, Arity> {
+    static int select(const int* children, int count, const std::greater<int>& comp) {
+        if (Arity % 4 == 0 && count == Arity) {
+            return heapSelectIntGroup<false, Arity>(children);
+        }
+        int best = 0;
+        for (int i = 1; i < count; ++i) {
+            if (comp(children[i], children[best])) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+#endif
+
+#endif // HEAPCHILDSELECTOR_H
@@ -0,0 +1,252 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Addressable d-ary heap. insert returns a handle that stays valid until the
+// element leaves the heap, and a position index (handle -> heap slot) kept up
+// to date by the sift routines lets decreaseKey, increaseKey and erase run in
+// O(log n). Handles of removed elements are recycled by later inserts.
+//
+// As in Heap, compare(a, b) is true when a belongs above b, so "decrease"
+// means moving toward the top: a smaller key in a min heap, a larger key in a
+// max heap.
+template <typename Key, typename Compare = std::less<Key>, int Arity = 2>
+class IndexedHeap {
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+public:
+    typedef int Handle;
+
+private:
+    struct Entry {
+        Key key;
+        Handle handle;
+    };
+
+    std::vector<Entry> entries;    // heap order
+    std::vector<int> position;     // heap slot of every handle, -1 when free
+    std::vector<Handle> freeHandles;
+    Compare comp;
+
+    void place(int index, Entry&& entry);
+    void reheapDown(int index);
+    void reheapUp(int index);
+    void removeAt(int index);
+    int slotOf(Handle handle) const;
+
+public:
+    explicit IndexedHeap(Compare comp = Compare()) : comp(comp) {}
+
+    Handle insert(const Key& key);
+    const Key& top() const;
+    Handle topHandle() const;
+    Key extract();
+    bool contains(Handle handle) const;
+    const Key& key(Handle handle) const;
+    void decreaseKey(Handle handle, const Key& key);
+    void increaseKey(Handle handle, const Key& key);
+    void update(Handle handle, const Key& key);
+    void erase(Handle handle);
+    void clear();
+    int getSize() const { return static_cast<int>(entries.size()); }
+    bool isEmpty() const { return entries.empty(); }
+};
+
+// Stores an entry at a heap slot and records the slot for its handle
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::place(int index, Entry&& entry) {
+    position[entry.handle] = index;
+    entries[index] = std::move(entry);
+}
+
+// Performs a downward heapification starting from the given index
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::reheapDown(int index) {
+    int size = getSize();
+    Entry value = std::move(entries[index]);
+    while (true) {
+        int first = Arity * index + 1;
+        if (first >= size) {
+            break;
+        }
+        int last = first + Arity < size ? first + Arity : size;
+        int best = first;
+        for (int child = first + 1; child < last; ++child) {
+            if (comp(entries[child].key, entries[best].key)) {
+                best = child;
+            }
+        }
+        if (!comp(entries[best].key, value.key)) {
+            break;
+        }
+        place(index, std::move(entries[best]));
+        index = best;
+    }
+    place(index, std::move(value));
+}
+
+// Performs an upward heapification starting from the given index
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::reheapUp(int index) {
+    Entry value = std::move(entries[index]);
+    while (index) {
+        int parent = (index - 1) / Arity;
+        if (!comp(value.key, entries[parent].key)) {
+            break;
+        }
+        place(index, std::move(entries[parent]));
+        index = parent;
+    }
+    place(index, std::move(value));
+}
+
+// Returns the heap slot of a live handle
+template <typename Key, typename Compare, int Arity>
+int IndexedHeap<Key, Compare, Arity>::slotOf(Handle handle) const {
+    if (!contains(handle)) {
+        throw std::runtime_error("Invalid heap handle");
+    }
+    return position[handle];
+}
+
+// Inserts a key and returns its handle
+template <typename Key, typename Compare, int Arity>
+typename IndexedHeap<Key, Compare, Arity>::Handle IndexedHeap<Key, Compare, Arity>::insert(const Key& key) {
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(position.size());
+        position.push_back(-1);
+    }
+    entries.push_back(Entry{key, handle});
+    reheapUp(getSize() - 1);
+    return handle;
+}
+
+// Returns the root key of the heap
+template <typename Key, typename Compare, int Arity>
+const Key& IndexedHeap<Key, Compare, Arity>::top() const {
+    if (entries.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return entries[0].key;
+}
+
+// Returns the handle of the root element
+template <typename Key, typename Compare, int Arity>
+typename IndexedHeap<Key, Compare, Arity>::Handle IndexedHeap<Key, Compare, Arity>::topHandle() const {
+    if (entries.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return entries[0].handle;
+}
+
+// Removes the element at a heap slot and restores the heap order. The root
+// has nowhere to move up to, so its key is never compared; extract relies on
+// this, having already moved that key out.
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::removeAt(int index) {
+    Handle handle = entries[index].handle;
+    position[handle] = -1;
+    freeHandles.push_back(handle);
+
+    int last = getSize() - 1;
+    if (index != last) {
+        bool movesUp = index > 0 && comp(entries[last].key, entries[index].key);
+        place(index, std::move(entries[last]));
+        entries.pop_back();
+        if (movesUp) {
+            reheapUp(index);
+        } else {
+            reheapDown(index);
+        }
+    } else {
+        entries.pop_back();
+    }
+}
+
+// Removes and returns the root key of the heap
+template <typename Key, typename Compare, int Arity>
+Key IndexedHeap<Key, Compare, Arity>::extract() {
+    if (entries.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    Key root = std::move(entries[0].key);
+    removeAt(0);
+    return root;
+}
+
+// Checks if a handle refers to an element currently in the heap
+template <typename Key, typename Compare, int Arity>
+bool IndexedHeap<Key, Compare, Arity>::contains(Handle handle) const {
+    return handle >= 0 && handle < static_cast<Handle>(position.size()) && position[handle] >= 0;
+}
+
+// Returns the key stored under a handle
+template <typename Key, typename Compare, int Arity>
+const Key& IndexedHeap<Key, Compare, Arity>::key(Handle handle) const {
+    return entries[slotOf(handle)].key;
+}
+
+// Moves an element toward the top; the new key must not belong below the old one
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::decreaseKey(Handle handle, const Key& key) {
+    int index = slotOf(handle);
+    if (comp(entries[index].key, key)) {
+        throw std::runtime_error("decreaseKey would move the element down");
+    }
+    entries[index].key = key;
+    reheapUp(index);
+}
+
+// Moves an element toward the bottom; the new key must not belong above the old one
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::increaseKey(Handle handle, const Key& key) {
+    int index = slotOf(handle);
+    if (comp(key, entries[index].key)) {
+        throw std::runtime_error("increaseKey would move the element up");
+    }
+    entries[index].key = key;
+    reheapDown(index);
+}
+
+// Changes the key of an element in either direction
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::update(Handle handle, const Key& key) {
+    int index = slotOf(handle);
+    bool movesUp = comp(key, entries[index].key);
+    entries[index].key = key;
+    if (movesUp) {
+        reheapUp(index);
+    } else {
+        reheapDown(index);
+    }
+}
+
+// Removes the element with the given handle
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::erase(Handle handle) {
+    removeAt(slotOf(handle));
+}
+
+// Removes every element and forgets all handles
+template <typename Key, typename Compare, int Arity>
+void IndexedHeap<Key, Compare, Arity>::clear() {
+    entries.clear();
+    position.clear();
+    freeHandles.clear();
+}
+
+template <typename Key>
+using IndexedMinHeap = IndexedHeap<Key, std::less<Key>>;
+
+template <typename Key>
+using IndexedMaxHeap = IndexedHeap<Key, std::greater<Key>>;
+
+#endif // INDEXEDHEAP_H
@@ -3,16 +3,21 @@
 
 #include "Heap.h"
 
-class MaxHeap : public Heap {
-protected:
-    void reheapDown(int index, bool (*compare)(int, int)) override;
-    void reheapUp(int index, bool (*compare)(int, int)) override;
+// Max heaps are Heap instantiations with std::greater, so the largest key is on top
+template <typename Key>
+using MaxHeapOf = Heap<Key, std::greater<Key>>;
 
+template <typename Key, typename Payload>
+using MaxPairHeap = Heap<std::pair<Key, Payload>, CompareByKey<std::greater<Key>>>;
+
+// 4-ary and 8-ary layouts keep each sibling group in one cache line
+template <typename Key, int Arity>
+using DaryMaxHeap = Heap<Key, std::greater<Key>, Arity>;
+
+class MaxHeap : public MaxHeapOf<int> {
 public:
-    static bool compare(int a, int b) {
-        return a > b;
-    }
-    int findMax() const;
+    // Returns the maximum element, or -1 if the heap is empty
+    int findMax() const { return isEmpty() ? -1 : top(); }
 };
 
 #endif // MAXHEAP_H
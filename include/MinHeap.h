@@ -3,16 +3,21 @@
 
 #include "Heap.h"
 
-class MinHeap : public Heap {
-protected:
-    void reheapDown(int index, bool (*compare)(int, int)) override;
-    void reheapUp(int index, bool (*compare)(int, int)) override;
+// Min heaps are Heap instantiations with std::less, so the smallest key is on top
+template <typename Key>
+using MinHeapOf = Heap<Key, std::less<Key>>;
 
+template <typename Key, typename Payload>
+using MinPairHeap = Heap<std::pair<Key, Payload>, CompareByKey<std::less<Key>>>;
+
+// 4-ary and 8-ary layouts keep each sibling group in one cache line
+template <typename Key, int Arity>
+using DaryMinHeap = Heap<Key, std::less<Key>, Arity>;
+
+class MinHeap : public MinHeapOf<int> {
 public:
-    static bool compare(int a, int b) {
-        return a < b;
-    }
-    int findMin() const;
+    // Returns the minimum element, or -1 if the heap is empty
+    int findMin() const { return isEmpty() ? -1 : top(); }
 };
 
 #endif // MINHEAP_H
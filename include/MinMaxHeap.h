@@ -0,0 +1,211 @@
+#ifndef MINMAXHEAP_H
+#define MINMAXHEAP_H
+
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Double-ended heap (min-max heap). Even levels, starting with the root, are
+// ordered like a MinHeap and odd levels like a MaxHeap, so both the minimum
+// (the root) and the maximum (one of the root's children) are found in O(1),
+// and either end is removed in O(log n). One structure answers FINDMIN and
+// FINDMAX, where a MinHeap/MaxHeap pair would store every element twice.
+template <typename Key, typename Compare = std::less<Key>>
+class MinMaxHeap {
+private:
+    std::vector<Key> data;
+    Compare comp;
+
+    static bool isMinLevel(int index);
+    bool before(const Key& a, const Key& b, bool minLevel) const;
+    void trickleDown(int index);
+    void bubbleUp(int index);
+    void bubbleUpLevel(int index, bool minLevel);
+    int maxIndex() const;
+
+public:
+    explicit MinMaxHeap(Compare comp = Compare()) : comp(comp) {}
+
+    void buildHeap(const Key* elements, int size);
+    void insert(const Key& element);
+    const Key& findMin() const;
+    const Key& findMax() const;
+    Key deleteMin();
+    Key deleteMax();
+    int getSize() const { return static_cast<int>(data.size()); }
+    bool isEmpty() const { return data.empty(); }
+    void printHeap(std::string heaptype, std::ofstream& output);
+};
+
+// Checks if an index lies on a min (even) level
+template <typename Key, typename Compare>
+bool MinMaxHeap<Key, Compare>::isMinLevel(int index) {
+    int level = 31 - __builtin_clz(static_cast<unsigned>(index + 1));
+    return (level & 1) == 0;
+}
+
+// Checks if a belongs above b on a min level (smaller) or a max level (larger)
+template <typename Key, typename Compare>
+bool MinMaxHeap<Key, Compare>::before(const Key& a, const Key& b, bool minLevel) const {
+    return minLevel ? comp(a, b) : comp(b, a);
+}
+
+// Performs a downward heapification starting from the given index. On a min
+// level the element sinks past the smallest child or grandchild, on a max
+// level past the largest.
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::trickleDown(int index) {
+    int size = getSize();
+    bool minLevel = isMinLevel(index);
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) {
+            return;
+        }
+
+        int best = child;
+        int candidates[5] = {child + 1, 2 * child + 1, 2 * child + 2, 2 * child + 3, 2 * child + 4};
+        for (int candidate : candidates) {
+            if (candidate < size && before(data[candidate], data[best], minLevel)) {
+                best = candidate;
+            }
+        }
+
+        if (!before(data[best], data[index], minLevel)) {
+            return;
+        }
+        std::swap(data[best], data[index]);
+        if (best <= child + 1) {
+            return;
+        }
+
+        // best is a grandchild: its parent sits on the opposite kind of level
+        int parent = (best - 1) / 2;
+        if (before(data[parent], data[best], minLevel)) {
+            std::swap(data[parent], data[best]);
+        }
+        index = best;
+    }
+}
+
+// Moves an element up through the grandparents on its own kind of level
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::bubbleUpLevel(int index, bool minLevel) {
+    while (index > 2) {
+        int grandparent = ((index - 1) / 2 - 1) / 2;
+        if (!before(data[index], data[grandparent], minLevel)) {
+            return;
+        }
+        std::swap(data[index], data[grandparent]);
+        index = grandparent;
+    }
+}
+
+// Performs an upward heapification starting from the given index
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::bubbleUp(int index) {
+    if (index == 0) {
+        return;
+    }
+    bool minLevel = isMinLevel(index);
+    int parent = (index - 1) / 2;
+    if (before(data[parent], data[index], minLevel)) {
+        // Belongs on the parent's kind of level instead
+        std::swap(data[parent], data[index]);
+        bubbleUpLevel(parent, !minLevel);
+    } else {
+        bubbleUpLevel(index, minLevel);
+    }
+}
+
+// Returns the index of the maximum element
+template <typename Key, typename Compare>
+int MinMaxHeap<Key, Compare>::maxIndex() const {
+    if (getSize() == 1) {
+        return 0;
+    }
+    if (getSize() == 2 || !comp(data[1], data[2])) {
+        return 1;
+    }
+    return 2;
+}
+
+// Builds the heap from an array of elements
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::buildHeap(const Key* elements, int size) {
+    data.assign(elements, elements + size);
+    for (int i = size / 2 - 1; i >= 0; --i) {
+        trickleDown(i);
+    }
+}
+
+// Inserts an element into the heap
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::insert(const Key& element) {
+    data.push_back(element);
+    bubbleUp(getSize() - 1);
+}
+
+// Returns the minimum element
+template <typename Key, typename Compare>
+const Key& MinMaxHeap<Key, Compare>::findMin() const {
+    if (data.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return data[0];
+}
+
+// Returns the maximum element
+template <typename Key, typename Compare>
+const Key& MinMaxHeap<Key, Compare>::findMax() const {
+    if (data.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return data[maxIndex()];
+}
+
+// Removes and returns the minimum element
+template <typename Key, typename Compare>
+Key MinMaxHeap<Key, Compare>::deleteMin() {
+    if (data.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    Key result = std::move(data[0]);
+    data[0] = std::move(data.back());
+    data.pop_back();
+    if (!data.empty()) {
+        trickleDown(0);
+    }
+    return result;
+}
+
+// Removes and returns the maximum element
+template <typename Key, typename Compare>
+Key MinMaxHeap<Key, Compare>::deleteMax() {
+    if (data.empty()) {
+        throw std::runtime_error("Heap is empty");
+    }
+    int index = maxIndex();
+    Key result = std::move(data[index]);
+    data[index] = std::move(data.back());
+    data.pop_back();
+    if (index < getSize()) {
+        trickleDown(index);
+    }
+    return result;
+}
+
+// Prints the heap to a file
+template <typename Key, typename Compare>
+void MinMaxHeap<Key, Compare>::printHeap(std::string heaptype, std::ofstream& output) {
+    output << heaptype;
+    for (const Key& element : data) {
+        output << element << " ";
+    }
+    output << std::endl;
+}
+
+#endif // MINMAXHEAP_H
@@ -0,0 +1,136 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "Heap.h"
+
+// Relaxed concurrent priority queue (MultiQueue). Elements are spread over
+// several Heaps, each guarded by its own mutex. push locks one random heap;
+// tryPop locks two random heaps and removes the better of their tops. Many
+// threads can therefore push and pop at once, at the price of pops returning
+// an element near the top rather than exactly the top. With Compare =
+// std::less it behaves like a relaxed MinHeap, with std::greater like a
+// relaxed MaxHeap.
+template <typename Key, typename Compare = std::less<Key>, int Arity = 4>
+class MultiQueue {
+private:
+    // Each sub-queue sits on its own cache lines so locks do not false-share
+    struct alignas(64) Queue {
+        std::mutex lock;
+        Heap<Key, Compare, Arity> heap;
+    };
+
+    int queueCount;
+    std::unique_ptr<Queue[]> queues;
+    std::atomic<long> elementCount;
+    Compare comp;
+
+    int randomQueue();
+
+public:
+    explicit MultiQueue(int queueCount = 2 * static_cast<int>(std::thread::hardware_concurrency()));
+    MultiQueue(const MultiQueue&) = delete;
+    MultiQueue& operator=(const MultiQueue&) = delete;
+
+    void push(const Key& element);
+    bool tryPop(Key& element);
+    long getSize() const;
+    bool isEmpty() const;
+};
+
+// Constructor to create queueCount independently locked heaps
+template <typename Key, typename Compare, int Arity>
+MultiQueue<Key, Compare, Arity>::MultiQueue(int queueCount)
+    : queueCount(queueCount > 1 ? queueCount : 2), queues(new Queue[this->queueCount]), elementCount(0) {}
+
+// Returns a random sub-queue index from a per-thread generator
+template <typename Key, typename Compare, int Arity>
+int MultiQueue<Key, Compare, Arity>::randomQueue() {
+    thread_local std::minstd_rand generator(static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+    return static_cast<int>(generator() % queueCount);
+}
+
+// Inserts an element into a random sub-queue that is not locked by another thread
+template <typename Key, typename Compare, int Arity>
+void MultiQueue<Key, Compare, Arity>::push(const Key& element) {
+    while (true) {
+        Queue& queue = queues[randomQueue()];
+        if (queue.lock.try_lock()) {
+            queue.heap.insert(element);
+            elementCount.fetch_add(1, std::memory_order_relaxed);
+            queue.lock.unlock();
+            return;
+        }
+    }
+}
+
+// Removes the better top of two random sub-queues. Returns false only after a
+// full sweep found every sub-queue empty.
+template <typename Key, typename Compare, int Arity>
+bool MultiQueue<Key, Compare, Arity>::tryPop(Key& element) {
+    for (int attempt = 0; attempt < 2 * queueCount; ++attempt) {
+        if (elementCount.load(std::memory_order_relaxed) <= 0) {
+            break;
+        }
+        int first = randomQueue();
+        int second = randomQueue();
+        if (first == second) {
+            continue;
+        }
+        std::unique_lock<std::mutex> firstLock(queues[first].lock, std::try_to_lock);
+        if (!firstLock.owns_lock()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> secondLock(queues[second].lock, std::try_to_lock);
+        if (!secondLock.owns_lock()) {
+            continue;
+        }
+
+        Heap<Key, Compare, Arity>* best = &queues[first].heap;
+        Heap<Key, Compare, Arity>* other = &queues[second].heap;
+        if (best->isEmpty() || (!other->isEmpty() && comp(other->top(), best->top()))) {
+            best = other;
+        }
+        if (!best->isEmpty()) {
+            element = best->extract();
+            elementCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Sampling kept missing; sweep every sub-queue so a non-empty queue is never reported empty
+    for (int i = 0; i < queueCount; ++i) {
+        std::lock_guard<std::mutex> guard(queues[i].lock);
+        if (!queues[i].heap.isEmpty()) {
+            element = queues[i].heap.extract();
+            elementCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the number of queued elements (a snapshot while other threads run)
+template <typename Key, typename Compare, int Arity>
+long MultiQueue<Key, Compare, Arity>::getSize() const {
+    return elementCount.load(std::memory_order_relaxed);
+}
+
+// Checks if the queue is empty (a snapshot while other threads run)
+template <typename Key, typename Compare, int Arity>
+bool MultiQueue<Key, Compare, Arity>::isEmpty() const {
+    return getSize() <= 0;
+}
+
+template <typename Key>
+using MinMultiQueue = MultiQueue<Key, std::less<Key>>;
+
+template <typename Key>
+using MaxMultiQueue = MultiQueue<Key, std::greater<Key>>;
+
+#endif // MULTIQUEUE_H
@@ -0,0 +1,139 @@
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Slab allocator for tree nodes addressed by 32-bit indices. Storage is a
+// list of segments that double in size (64, 128, 256, ... nodes), so growing
+// the arena never moves existing nodes: references and indices stay valid,
+// and the whole arena is released in one sweep on clear or destruction.
+// Released indices are recycled by later allocations.
+template <typename Node>
+class NodeArena {
+public:
+    typedef uint32_t Index;
+    static const Index Nil = 0xFFFFFFFFu;
+
+private:
+    static const int FirstSegmentBits = 6;
+    static const int MaxSegments = 25;
+
+    Node* segments[MaxSegments];
+    Index highWater;
+    std::vector<Index> freeIndices;
+
+    // Maps an index to its segment and the offset inside that segment
+    static int locate(Index index, Index& offset) {
+        Index shifted = index + (1u << FirstSegmentBits);
+        int segment = 31 - __builtin_clz(shifted) - FirstSegmentBits;
+        offset = shifted - ((1u << FirstSegmentBits) << segment);
+        return segment;
+    }
+
+public:
+    NodeArena() : highWater(0) {
+        for (int i = 0; i < MaxSegments; ++i) {
+            segments[i] = nullptr;
+        }
+    }
+
+    ~NodeArena() {
+        clear();
+    }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    NodeArena(NodeArena&& other) noexcept : highWater(0) {
+        for (int i = 0; i < MaxSegments; ++i) {
+            segments[i] = nullptr;
+        }
+        swap(other);
+    }
+
+    NodeArena& operator=(NodeArena&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    // Exchanges the storage of two arenas
+    void swap(NodeArena& other) noexcept {
+        for (int i = 0; i < MaxSegments; ++i) {
+            std::swap(segments[i], other.segments[i]);
+        }
+        std::swap(highWater, other.highWater);
+        freeIndices.swap(other.freeIndices);
+    }
+
+    Node& operator[](Index index) {
+        Index offset;
+        int segment = locate(index, offset);
+        return segments[segment][offset];
+    }
+
+    const Node& operator[](Index index) const {
+        Index offset;
+        int segment = locate(index, offset);
+        return segments[segment][offset];
+    }
+
+    // Stores a node and returns its index
+    Index allocate(const Node& value) {
+        Index index;
+        if (!freeIndices.empty()) {
+            index = freeIndices.back();
+            freeIndices.pop_back();
+        } else {
+            index = highWater;
+            Index offset;
+            int segment = locate(index, offset);
+            if (segment >= MaxSegments) {
+                throw std::length_error("NodeArena is full");
+            }
+            if (!segments[segment]) {
+                segments[segment] = new Node[(1u << FirstSegmentBits) << segment];
+            }
+            ++highWater;
+        }
+        (*this)[index] = value;
+        return index;
+    }
+
+    // Returns a node's slot to the arena for reuse
+    void release(Index index) {
+        freeIndices.push_back(index);
+    }
+
+    // Frees every node at once
+    void clear() {
+        for (int i = 0; i < MaxSegments; ++i) {
+            delete[] segments[i];
+            segments[i] = nullptr;
+        }
+        highWater = 0;
+        freeIndices.clear();
+    }
+
+    // Returns the number of nodes currently allocated
+    std::size_t liveCount() const {
+        return highWater - freeIndices.size();
+    }
+
+    // Returns the bytes held in node segments
+    std::size_t bytesReserved() const {
+        std::size_t bytes = 0;
+        for (int i = 0; i < MaxSegments && segments[i]; ++i) {
+            bytes += ((std::size_t(1) << FirstSegmentBits) << i) * sizeof(Node);
+        }
+        return bytes;
+    }
+};
+
+#endif // NODEARENA_H
@@ -0,0 +1,50 @@
+#ifndef PERFECTHASHINDEX_H
+#define PERFECTHASHINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Static set of ints behind a minimal perfect hash function (BBHash). The
+// function maps each of the n keys to a distinct index in [0, n) and is
+// stored as a few levels of bit arrays, about 3 bits per key: a key's index
+// is the rank of the first level bit it lands on alone. Keys are stored at
+// their index, so a lookup computes the index and compares one key. The
+// index can be written to a stream and read back without rebuilding.
+class PerfectHashIndex {
+public:
+    PerfectHashIndex();
+
+    void build(const int* keys, std::size_t count);
+    void clear();
+    bool isBuilt() const { return built; }
+    std::size_t size() const { return keys.size(); }
+    const int* data() const { return keys.data(); }
+    std::size_t bytes() const;
+
+    long indexOf(int key) const;
+    bool contains(int key) const;
+
+    bool save(std::ostream& output) const;
+    bool load(std::istream& input);
+
+private:
+    static const int MaxLevels = 32;
+    static const int WordsPerBlock = 8;
+
+    std::vector<uint64_t> levelOffsets;  // first bit of each level, plus the end of the last
+    std::vector<uint64_t> bits;          // every level's bit array, back to back
+    std::vector<uint32_t> blockRanks;    // set bits before each block of WordsPerBlock words
+    std::vector<int> fallback;           // sorted keys that collided on every level
+    std::vector<int> keys;               // keys[indexOf(key)] == key
+    bool built;
+
+    static uint64_t levelHash(int key, int level);
+    uint64_t rank(uint64_t position) const;
+    long lookup(int key) const;
+    bool consistent() const;
+};
+
+#endif // PERFECTHASHINDEX_H
@@ -0,0 +1,99 @@
+#ifndef PERSISTENTAVLTREE_H
+#define PERSISTENTAVLTREE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "AVLTree.h"
+
+// AVL tree whose published versions are immutable. An update copies the path
+// from the changed node up to the root (plus any rotated nodes), then
+// publishes the new root with one atomic store, so readers never wait for
+// the writer. A reader takes a Snapshot, which pins the version it saw;
+// nodes replaced by later updates are reclaimed with epoch-based reclamation
+// once no snapshot that could still reach them is alive. Updates from
+// several threads are serialized by a writer mutex.
+class PersistentAVLTree {
+public:
+    // Read handle on one published version. Cheap to take; keep it short-lived,
+    // since nodes retired after it was taken are held until it is destroyed.
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept;
+        ~Snapshot();
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        bool contains(int key) const;
+        int getSize() const;
+        int findMin() const;
+
+    private:
+        friend class PersistentAVLTree;
+        explicit Snapshot(const PersistentAVLTree* tree);
+
+        const PersistentAVLTree* tree;
+        int slot;
+        AVLIndex root;
+    };
+
+    PersistentAVLTree();
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    void insert(int key);
+    void deleteNode(int key);
+    void buildTree(int* elements, int size);
+    Snapshot snapshot() const;
+    int getSize() const;
+    std::size_t pendingReclamation() const;
+
+private:
+    static const int MaxReaders = 128;
+
+    // Reader announcement; epoch 0 means the slot holds no version
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> inUse;
+        std::atomic<uint64_t> epoch;
+        ReaderSlot() : inUse(false), epoch(0) {}
+    };
+
+    struct RetiredBatch {
+        uint64_t epoch;
+        std::vector<AVLIndex> nodes;
+    };
+
+    NodeArena<AVLNode> nodes;
+    std::atomic<AVLIndex> root;
+    std::atomic<uint64_t> globalEpoch;
+    mutable ReaderSlot readers[MaxReaders];
+    mutable std::mutex writeLock;
+
+    // Writer-only bookkeeping for the update in progress
+    std::vector<uint8_t> fresh;
+    std::vector<AVLIndex> created;
+    std::vector<AVLIndex> retiring;
+    std::deque<RetiredBatch> retired;
+
+    int height(AVLIndex node) const;
+    int size(AVLIndex node) const;
+    void update(AVLIndex node);
+    AVLIndex make(const AVLNode& node);
+    AVLIndex writable(AVLIndex node);
+    void discard(AVLIndex node);
+    AVLIndex rotateRight(AVLIndex y);
+    AVLIndex rotateLeft(AVLIndex x);
+    AVLIndex rebalance(AVLIndex node);
+    AVLIndex insert(AVLIndex node, int key);
+    AVLIndex deleteNode(AVLIndex node, int key);
+    AVLIndex deleteMin(AVLIndex node, int& minKey);
+    AVLIndex buildSorted(const int* keys, int count);
+    void retireSubtree(AVLIndex node);
+    void publish(AVLIndex newRoot);
+    void reclaim();
+};
+
+#endif // PERSISTENTAVLTREE_H
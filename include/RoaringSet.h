@@ -0,0 +1,90 @@
+#ifndef ROARINGSET_H
+#define ROARINGSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed set of ints in the style of Roaring bitmaps. Keys are split by
+// their upper 16 bits into chunks of 65536; each chunk is stored in the
+// container that suits its density: a sorted array of 16-bit values (up to
+// 4096 keys, 2 bytes per key), a 65536-bit bitmap (8 KB, one bit test per
+// lookup), or a list of runs for consecutive ranges after optimize(). Dense
+// ranges of IDs therefore take about one bit per key.
+class RoaringSet {
+public:
+    RoaringSet();
+
+    bool add(int key);
+    bool remove(int key);
+    bool contains(int key) const;
+    std::size_t getSize() const { return cardinality; }
+    void clear();
+    void optimize();
+    void unionWith(const RoaringSet& other);
+    void intersectWith(const RoaringSet& other);
+    std::size_t bytes() const;
+
+    // Calls visit(key) for every key in ascending order
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+private:
+    static const int ArrayLimit = 4096;
+    static const int BitmapWords = 1024;
+
+    enum ContainerType : uint8_t { ArrayContainer, BitmapContainer, RunContainer };
+
+    struct Container {
+        uint16_t high;
+        ContainerType type;
+        int count;
+        std::vector<uint16_t> values;   // array: sorted values; run: (start, length - 1) pairs
+        std::vector<uint64_t> words;    // bitmap: BitmapWords words
+    };
+
+    std::vector<Container> containers;  // sorted by high
+    std::size_t cardinality;
+
+    static uint32_t toUnsigned(int key) { return static_cast<uint32_t>(key) ^ 0x80000000u; }
+    static int toKey(uint32_t value) { return static_cast<int>(value ^ 0x80000000u); }
+
+    int findContainer(uint16_t high) const;
+    static bool containerContains(const Container& container, uint16_t low);
+    static void toBitmap(Container& container);
+    static void toArray(Container& container);
+    static void expandRuns(Container& container);
+    static void countBitmap(Container& container);
+    static void shrinkBitmap(Container& container);
+    static int countRuns(const Container& container);
+    static void toRuns(Container& container);
+    static void unionContainer(Container& target, const Container& source);
+    static void intersectContainer(Container& target, const Container& source);
+};
+
+template <typename Visitor>
+void RoaringSet::forEach(Visitor visit) const {
+    for (const Container& container : containers) {
+        uint32_t base = static_cast<uint32_t>(container.high) << 16;
+        if (container.type == ArrayContainer) {
+            for (uint16_t low : container.values) {
+                visit(toKey(base | low));
+            }
+        } else if (container.type == BitmapContainer) {
+            for (int i = 0; i < BitmapWords; ++i) {
+                for (uint64_t word = container.words[i]; word; word &= word - 1) {
+                    visit(toKey(base | static_cast<uint32_t>(i * 64 + __builtin_ctzll(word))));
+                }
+            }
+        } else {
+            for (std::size_t i = 0; i < container.values.size(); i += 2) {
+                uint32_t start = container.values[i];
+                for (uint32_t low = start; low <= start + container.values[i + 1]; ++low) {
+                    visit(toKey(base | low));
+                }
+            }
+        }
+    }
+}
+
+#endif // ROARINGSET_H
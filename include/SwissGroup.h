@@ -0,0 +1,57 @@
+#ifndef SWISSGROUP_H
+#define SWISSGROUP_H
+
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Control-byte helpers shared by the open-addressing hash tables. Each slot
+// has one control byte: swissEmpty, swissDeleted, or the low 7 bits of the
+// key's hash (a non-negative value). Slots are probed a 16-byte group at a time.
+const int swissGroupSize = 16;
+const int8_t swissEmpty = -128;
+const int8_t swissDeleted = -2;
+
+// Returns a bit mask of the control bytes in a 16-byte aligned group that equal value
+inline uint32_t swissMatch(const int8_t* group, int8_t value) {
+#if defined(__SSE2__)
+    __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < swissGroupSize; ++i) {
+        mask |= static_cast<uint32_t>(group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+// Returns a bit mask of the empty or deleted slots in a 16-byte aligned group
+inline uint32_t swissMatchFree(const int8_t* group) {
+#if defined(__SSE2__)
+    __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(bytes, _mm_set1_epi8(-1))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < swissGroupSize; ++i) {
+        mask |= static_cast<uint32_t>(group[i] < -1) << i;
+    }
+    return mask;
+#endif
+}
+
+// Mixes every key bit into every hash bit (the MurmurHash3 finalizer), so
+// keys that differ only in high bits, or are negative, still spread evenly
+inline uint64_t swissHash(int key) {
+    uint64_t hash = static_cast<uint32_t>(key);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+#endif // SWISSGROUP_H
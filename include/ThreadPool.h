@@ -0,0 +1,45 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. run(count, task)
+// hands the indices 0 .. count - 1 out one at a time to whichever worker is
+// free and returns once all of them are done; the calling thread works as
+// worker 0, so a pool of size 1 starts no threads at all. The worker number
+// passed to task lets it use per-worker scratch state without locking.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void run(int count, const std::function<void(int index, int worker)>& task);
+    int size() const { return static_cast<int>(threads.size()) + 1; }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex lock;
+    std::mutex runLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    // Job in progress, published under lock with a new generation number
+    const std::function<void(int, int)>* task;
+    int count;
+    std::atomic<int> next;
+    int busy;
+    unsigned generation;
+    bool stopping;
+
+    void work(int worker);
+    void loop(int worker);
+};
+
+#endif // THREADPOOL_H
@@ -2,6 +2,7 @@
 This program implements a library for executing various operations on different data structures:
 - MinHeap
 - MaxHeap
+- MinMaxHeap
 - AVL Tree
 - Graph
 - Hash Table
@@ -10,13 +11,14 @@ The main function initializes instances of these data structures and reads comma
 Each command specifies an action to perform on a specific data structure, along with optional parameters.
 
 Functions:
-- `readFile`: Reads integers from a file and stores them in an array.
+- `readFile`: Reads integers from a file and stores them in a vector.
 - `executeCommand`: Executes a command on the specified data structures and writes the output to a file.
 - `main`: Initializes data structures, reads commands from a file, executes commands, and writes the output to another file.
 
 Data Structures:
 - `MinHeap`: Implements a minimum heap.
 - `MaxHeap`: Implements a maximum heap.
+- `MinMaxHeap`: Implements a double-ended heap answering both minimum and maximum queries.
 - `AVLTree`: Implements an AVL tree.
 - `Graph`: Implements a graph.
 - `HashTable`: Implements a hash table.
@@ -28,17 +30,32 @@ Actions:
 - GETSIZE: Retrieves the size of a data structure.
 - FINDMIN: Finds the minimum element in a data structure.
 - FINDMAX: Finds the maximum element in a data structure.
-- SEARCH: Searches for an element in a data structure.
+- SEARCH: Searches for an element in a data structure (several keys at once for a hash table).
 - DELETE: Deletes an element from a data structure.
-- DELETEMIN: Deletes the minimum element from a min heap.
-- DELETEMAX: Deletes the maximum element from a max heap.
+- DELETEMIN: Deletes the minimum element from a min heap or min-max heap.
+- DELETEMAX: Deletes the maximum element from a max heap or min-max heap.
 - INSERT: Inserts an element into a data structure.
-- COMPUTESHORTESTPATH: Computes the shortest path in a graph using Dijkstra's algorithm.
-- COMPUTESPANNINGTREE: Computes the minimum spanning tree of a graph Kruskal's algorithm.
+- INSERTBATCH: Inserts several elements into a heap at once.
+- EXTRACTTOPK: Removes the k smallest (MinHeap) or largest (MaxHeap) elements of a heap.
+- FREEZE: Exports an AVL tree or hash table into a read-only search index used until the next change.
+- SAVE, LOAD: Write a frozen hash table to a binary file, or replace the hash table with one read from such a file.
+- FILTER: Puts a Bloom filter with the given false-positive rate (and optional byte limit) in front of a hash table.
+- JOIN: Merges the elements of a file into an AVL tree without reinserting them one by one.
+- UNION, INTERSECT: Combine a hash table with the set of keys in a file.
+- RANGE: Lists the elements of an AVL tree within a closed range.
+- RANK: Counts the elements of an AVL tree smaller than a key.
+- SELECT: Finds the element at a 0-based position of an AVL tree in sorted order.
+- COUNTRANGE: Counts the elements of an AVL tree within a closed range.
+- MEDIAN: Finds the (lower) median element of an AVL tree.
+- COMPUTESHORTESTPATH: Computes the shortest path in a graph using Dijkstra's algorithm (or the contraction hierarchy once built); several source/destination pairs are answered as one parallel batch.
+- COMPUTEPATH: Lists the vertices of a shortest path in a graph.
+- COMPUTEDISTANCES: Lists the shortest path cost from a vertex to every vertex of a graph ("-" if unreachable), optionally with the parallel DELTASTEPPING engine.
+- PREPROCESS: Builds a contraction hierarchy that speeds up graph shortest-path queries until the next edge change.
+- COMPUTESPANNINGTREE: Computes the minimum spanning tree of a graph with filter-Kruskal, or with parallel Boruvka when followed by BORUVKA.
 - FINDCONNECTEDCOMPONENTS: Finds the number of connected components in a graph using the DFS algorithm.
 
 Parameters:
-- MINHEAP, MAXHEAP, AVLTREE, HASHTABLE, GRAPH: Specifies the data structure.
+- MINHEAP, MAXHEAP, MINMAXHEAP, AVLTREE, HASHTABLE, GRAPH: Specifies the data structure.
 - Filename: Specifies the file from which to read data for building a data structure.
 - Number(s): Additional parameters required by certain actions, such as element value(s) or vertex indices.
 
@@ -52,15 +69,18 @@ Output:
 #include <sstream>
 #include <set>
 #include <chrono>
+#include <climits>
 #include <iomanip>
+#include <vector>
 #include "MinHeap.h"
 #include "MaxHeap.h"
+#include "MinMaxHeap.h"
 #include "AVLTree.h"
 #include "Graph.h"
 #include "HashTable.h"
 
 // Function to read integers from a file
-void readFile(const std::string& filename, int& size, int* elements, std::ofstream& output) {
+void readFile(const std::string& filename, int& size, std::vector<int>& elements, std::ofstream& output) {
     std::ifstream inputFile(filename);
     if (!inputFile.is_open()) {
         output << "Error: Could not open file " << filename << std::endl;
@@ -68,12 +88,13 @@ void readFile(const std::string& filename, int& size, int* elements, std::ofstre
     }
     int element;
     while (inputFile >> element) {
-        elements[size++] = element;
+        elements.push_back(element);
     }
+    size = static_cast<int>(elements.size());
 }
 
 // Function to execute a command from commands.txt
-void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHeap, AVLTree& avlTree, Graph& graph, HashTable& hashTable, std::ofstream& output) {
+void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHeap, MinMaxHeap<int>& minMaxHeap, AVLTree& avlTree, Graph& graph, HashTable& hashTable, std::ofstream& output) {
 
     std::istringstream isstr(command);
     std::string action, structureType, filename;
@@ -82,27 +103,32 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
     // Parsing actions and performing corresponding operations - an exhaustive list
     if (action == "BUILD") {
         int size = 0;
-        int* elements = new int[1000];
+        std::vector<int> elements;
         isstr >> structureType >> filename;
         // Building the specified data structure from a file
         if (structureType == "MINHEAP") {
             readFile(filename, size, elements, output);
-            minHeap.buildHeap(elements, size, MinHeap::compare);
+            minHeap.buildHeap(elements.data(), size);
             output << "Built MinHeap" << std::endl;
             //minHeap.printHeap("MinHeap: ", output);
         } else if (structureType == "MAXHEAP") {
             readFile(filename, size, elements, output);
-            maxHeap.buildHeap(elements, size, MaxHeap::compare);
+            maxHeap.buildHeap(elements.data(), size);
             output << "Built MaxHeap" << std::endl;
             //maxHeap.printHeap("MaxHeap: ", output);
+        } else if (structureType == "MINMAXHEAP") {
+            readFile(filename, size, elements, output);
+            minMaxHeap.buildHeap(elements.data(), size);
+            output << "Built MinMaxHeap" << std::endl;
+            //minMaxHeap.printHeap("MinMaxHeap: ", output);
         } else if (structureType == "AVLTREE") {
             readFile(filename, size, elements, output);
-            avlTree.buildTree(elements, size);
+            avlTree.buildTree(elements.data(), size);
             output << "Built AVL Tree" << std::endl;
             //avlTree.printAVLTree(output);
         } else if (structureType == "HASHTABLE") {
             readFile(filename, size, elements, output);
-            hashTable.buildTable(elements, size);
+            hashTable.buildTable(elements.data(), size);
             output << "Built Hash Table" << std::endl;
             //hashTable.printTable(output);
         } else if (structureType == "GRAPH") {
@@ -123,14 +149,14 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
             output << "Built Graph" << std::endl;
             //graph.printGraph(output);
         }
-
-        delete[] elements;
     } else if (action == "GETSIZE") {
         isstr >> structureType;
         if (structureType == "MINHEAP") {
             output << "Size of MinHeap: " << minHeap.getSize() << std::endl;
         } else if (structureType == "MAXHEAP") {
             output << "Size of MaxHeap: " << maxHeap.getSize() << std::endl;
+        } else if (structureType == "MINMAXHEAP") {
+            output << "Size of MinMaxHeap: " << minMaxHeap.getSize() << std::endl;
         } else if (structureType == "AVLTREE") {
             output << "Size of AVL Tree: " << avlTree.getSize() << std::endl;
         } else if (structureType == "HASHTABLE") {
@@ -142,6 +168,8 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
         isstr >> structureType;
         if (structureType == "MINHEAP") {
             output << "Minimum element in Min Heap: " << minHeap.findMin() << std::endl;
+        } else if (structureType == "MINMAXHEAP") {
+            output << "Minimum element in MinMax Heap: " << (minMaxHeap.isEmpty() ? -1 : minMaxHeap.findMin()) << std::endl;
         } else if (structureType == "AVLTREE") {
             output << "Minimum element in AVL Tree: " << avlTree.findMin() << std::endl;
         }
@@ -149,6 +177,8 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
         isstr >> structureType;
         if (structureType == "MAXHEAP") {
             output << "Maximum element in Max Heap: " << maxHeap.findMax() << std::endl;
+        } else if (structureType == "MINMAXHEAP") {
+            output << "Maximum element in MinMax Heap: " << (minMaxHeap.isEmpty() ? -1 : minMaxHeap.findMax()) << std::endl;
         }
     } else if (action == "SEARCH") {
         int number;
@@ -160,10 +190,19 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
                 output << "FAILURE: Element " << number << " not found in AVL Tree" << std::endl;
             }
         } else if (structureType == "HASHTABLE") {
-            if (hashTable.search(number) == "SUCCESS") {
-                output << "SUCCESS: Element " << number << " found in Hash Table" << std::endl;
-            } else {
-                output << "FAILURE: Element " << number << " not found in Hash Table" << std::endl;
+            // Any further keys on the line are looked up in the same batch
+            std::vector<int> numbers(1, number);
+            while (isstr >> number) {
+                numbers.push_back(number);
+            }
+            std::vector<uint8_t> found((numbers.size() + 7) / 8);
+            hashTable.searchBatch(numbers.data(), numbers.size(), found.data());
+            for (size_t i = 0; i < numbers.size(); ++i) {
+                if (found[i / 8] & (1u << (i % 8))) {
+                    output << "SUCCESS: Element " << numbers[i] << " found in Hash Table" << std::endl;
+                } else {
+                    output << "FAILURE: Element " << numbers[i] << " not found in Hash Table" << std::endl;
+                }
             }
         }
     } else if (action == "DELETE") {
@@ -173,6 +212,12 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
             avlTree.deleteNode(number);
             output << "Deleted element " << number << " from AVL Tree" << std::endl;
             //avlTree.printAVLTree(output);
+        } else if (structureType == "HASHTABLE") {
+            if (hashTable.erase(number)) {
+                output << "Deleted element " << number << " from Hash Table" << std::endl;
+            } else {
+                output << "FAILURE: Element " << number << " not found in Hash Table" << std::endl;
+            }
         } else if (structureType == "GRAPH") {
             int number2;
             isstr >> number2;
@@ -183,26 +228,36 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
     } else if (action == "DELETEMIN") {
         isstr >> structureType;
         if (structureType == "MINHEAP") {
-            output << "Deleted minimum element " << minHeap.extract(minHeap.compare) << " from MinHeap" << std::endl;
+            output << "Deleted minimum element " << minHeap.extract() << " from MinHeap" << std::endl;
             //minHeap.printHeap("MinHeap: ", output);
+        } else if (structureType == "MINMAXHEAP") {
+            output << "Deleted minimum element " << minMaxHeap.deleteMin() << " from MinMaxHeap" << std::endl;
+            //minMaxHeap.printHeap("MinMaxHeap: ", output);
         }
     } else if (action == "DELETEMAX") {
         isstr >> structureType;
         if (structureType == "MAXHEAP") {
-            output << "Deleted maximum element " << maxHeap.extract(maxHeap.compare) << " from MaxHeap" << std::endl;
+            output << "Deleted maximum element " << maxHeap.extract() << " from MaxHeap" << std::endl;
             //maxHeap.printHeap("MaxHeap: ", output);
+        } else if (structureType == "MINMAXHEAP") {
+            output << "Deleted maximum element " << minMaxHeap.deleteMax() << " from MinMaxHeap" << std::endl;
+            //minMaxHeap.printHeap("MinMaxHeap: ", output);
         }
     } else if (action == "INSERT") {
         int number, number2;
         isstr >> structureType >> number;
         if (structureType == "MINHEAP") {
-            minHeap.insert(number, minHeap.compare);
+            minHeap.insert(number);
             output << "Inserted " << number << " to MinHeap" << std::endl;
             //minHeap.printHeap("MinHeap: ", output);
         } else if (structureType == "MAXHEAP") {
-            maxHeap.insert(number, maxHeap.compare);
+            maxHeap.insert(number);
             output << "Inserted " << number << " to MaxHeap" << std::endl;
             //maxHeap.printHeap("MaxHeap: ", output);
+        } else if (structureType == "MINMAXHEAP") {
+            minMaxHeap.insert(number);
+            output << "Inserted " << number << " to MinMaxHeap" << std::endl;
+            //minMaxHeap.printHeap("MinMaxHeap: ", output);
         } else if (structureType == "AVLTREE") {
             avlTree.insert(number);
             output << "Inserted " << number << " to AVL Tree" << std::endl;
@@ -217,14 +272,177 @@ void executeCommand(const std::string& command, MinHeap& minHeap, MaxHeap& maxHe
             output << "Inserted edge (" << number << ", " << number2 << ") to Graph" << std::endl;
             //graph.printGraph(output);
         }
+    } else if (action == "INSERTBATCH") {
+        std::vector<int> numbers;
+        int number;
+        isstr >> structureType;
+        while (isstr >> number) {
+            numbers.push_back(number);
+        }
+        if (structureType == "MINHEAP") {
+            minHeap.insertBatch(numbers.data(), static_cast<int>(numbers.size()));
+            output << "Inserted " << numbers.size() << " elements to MinHeap" << std::endl;
+        } else if (structureType == "MAXHEAP") {
+            maxHeap.insertBatch(numbers.data(), static_cast<int>(numbers.size()));
+            output << "Inserted " << numbers.size() << " elements to MaxHeap" << std::endl;
+        }
+    } else if (action == "EXTRACTTOPK") {
+        int k = 0;
+        isstr >> structureType >> k;
+        std::vector<int> top(k > 0 ? k : 0);
+        if (structureType == "MINHEAP") {
+            int count = minHeap.extractTopK(k, top.data());
+            output << "Extracted " << count << " smallest elements from MinHeap:";
+            for (int i = 0; i < count; ++i) {
+                output << " " << top[i];
+            }
+            output << std::endl;
+        } else if (structureType == "MAXHEAP") {
+            int count = maxHeap.extractTopK(k, top.data());
+            output << "Extracted " << count << " largest elements from MaxHeap:";
+            for (int i = 0; i < count; ++i) {
+                output << " " << top[i];
+            }
+            output << std::endl;
+        }
+    } else if (action == "FREEZE") {
+        isstr >> structureType;
+        if (structureType == "AVLTREE") {
+            avlTree.freeze();
+            output << "Froze AVL Tree for searching" << std::endl;
+        } else if (structureType == "HASHTABLE") {
+            hashTable.freeze();
+            output << "Froze Hash Table into a perfect hash index" << std::endl;
+        }
+    } else if (action == "SAVE" || action == "LOAD") {
+        isstr >> structureType >> filename;
+        if (structureType == "HASHTABLE") {
+            if (action == "SAVE" ? hashTable.save(filename) : hashTable.load(filename)) {
+                output << (action == "SAVE" ? "Saved Hash Table to " : "Loaded Hash Table from ") << filename << std::endl;
+            } else {
+                output << "Error: Could not " << (action == "SAVE" ? "write" : "read") << " file " << filename << std::endl;
+            }
+        }
+    } else if (action == "FILTER") {
+        double rate = 0.01;
+        long maxBytes = 0;
+        isstr >> structureType >> rate >> maxBytes;
+        if (structureType == "HASHTABLE") {
+            hashTable.enableFilter(rate, maxBytes > 0 ? static_cast<size_t>(maxBytes) : 0);
+            output << "Enabled Bloom filter on Hash Table (" << hashTable.getFilterBytes() << " bytes)" << std::endl;
+        }
+    } else if (action == "JOIN") {
+        int size = 0;
+        std::vector<int> elements;
+        isstr >> structureType >> filename;
+        if (structureType == "AVLTREE") {
+            readFile(filename, size, elements, output);
+            AVLTree batch;
+            batch.buildTree(elements.data(), size);
+            avlTree.join(batch);
+            output << "Joined " << filename << " into AVL Tree" << std::endl;
+            //avlTree.printAVLTree(output);
+        }
+    } else if (action == "UNION" || action == "INTERSECT") {
+        int size = 0;
+        std::vector<int> elements;
+        isstr >> structureType >> filename;
+        if (structureType == "HASHTABLE") {
+            readFile(filename, size, elements, output);
+            HashTable other(size);
+            other.buildTable(elements.data(), size);
+            if (action == "UNION") {
+                hashTable.unionWith(other);
+                output << "United Hash Table with " << filename << std::endl;
+            } else {
+                hashTable.intersectWith(other);
+                output << "Intersected Hash Table with " << filename << std::endl;
+            }
+        }
+    } else if (action == "RANGE") {
+        int lo, hi;
+        isstr >> structureType >> lo >> hi;
+        if (structureType == "AVLTREE") {
+            output << "Elements of AVL Tree in [" << lo << ", " << hi << "]:";
+            avlTree.forEachInRange(lo, hi, [&output](int key) { output << " " << key; });
+            output << std::endl;
+        }
+    } else if (action == "RANK") {
+        int number;
+        isstr >> structureType >> number;
+        if (structureType == "AVLTREE") {
+            output << "Rank of " << number << " in AVL Tree: " << avlTree.rank(number) << std::endl;
+        }
+    } else if (action == "SELECT") {
+        int position;
+        isstr >> structureType >> position;
+        if (structureType == "AVLTREE") {
+            output << "Element at position " << position << " in AVL Tree: " << avlTree.select(position) << std::endl;
+        }
+    } else if (action == "COUNTRANGE") {
+        int lo, hi;
+        isstr >> structureType >> lo >> hi;
+        if (structureType == "AVLTREE") {
+            output << "Elements of AVL Tree in [" << lo << ", " << hi << "]: " << avlTree.countInRange(lo, hi) << std::endl;
+        }
+    } else if (action == "MEDIAN") {
+        isstr >> structureType;
+        if (structureType == "AVLTREE") {
+            output << "Median element in AVL Tree: " << avlTree.median() << std::endl;
+        }
     } else if (action == "COMPUTESHORTESTPATH") {
         int number1, number2;
         isstr >> structureType >> number1 >> number2;
-        int cost = graph.computeShortestPath(number1, number2);
-        output << "Shortest path from " << number1 << " to " << number2 << " costs " << cost << std::endl;
-    } else if (action == "COMPUTESPANNINGTREE") {
+        std::vector<std::pair<int, int>> queries(1, {number1, number2});
+        while (isstr >> number1 >> number2) {
+            queries.push_back({number1, number2});
+        }
+        if (queries.size() == 1) {
+            int cost = graph.computeShortestPath(queries[0].first, queries[0].second);
+            output << "Shortest path from " << queries[0].first << " to " << queries[0].second << " costs " << cost << std::endl;
+        } else {
+            std::vector<int> costs = graph.computeShortestPaths(queries);
+            for (size_t i = 0; i < queries.size(); ++i) {
+                output << "Shortest path from " << queries[i].first << " to " << queries[i].second << " costs " << costs[i] << std::endl;
+            }
+        }
+    } else if (action == "COMPUTEDISTANCES") {
+        int number;
+        std::string method;
+        isstr >> structureType >> number >> method;
+        std::vector<int> distances = graph.computeDistances(number, method == "DELTASTEPPING" ? ShortestPathMethod::DeltaStepping : ShortestPathMethod::Dijkstra);
+        output << "Distances from " << number << " in Graph:";
+        for (int distance : distances) {
+            if (distance == INT_MAX) {
+                output << " -";
+            } else {
+                output << " " << distance;
+            }
+        }
+        output << std::endl;
+    } else if (action == "COMPUTEPATH") {
+        int number1, number2;
+        isstr >> structureType >> number1 >> number2;
+        std::vector<int> path = graph.computePath(number1, number2);
+        if (path.empty()) {
+            output << "No path from " << number1 << " to " << number2 << std::endl;
+        } else {
+            output << "Shortest path from " << number1 << " to " << number2 << ":";
+            for (int v : path) {
+                output << " " << v;
+            }
+            output << std::endl;
+        }
+    } else if (action == "PREPROCESS") {
         isstr >> structureType;
-        int cost = graph.computeSpanningTree();
+        if (structureType == "GRAPH") {
+            graph.buildHierarchy();
+            output << "Contraction hierarchy of Graph built" << std::endl;
+        }
+    } else if (action == "COMPUTESPANNINGTREE") {
+        std::string method;
+        isstr >> structureType >> method;
+        int cost = graph.computeSpanningTree(method == "BORUVKA" ? SpanningTreeMethod::Boruvka : SpanningTreeMethod::Kruskal);
         output << "Spanning tree of Graph costs  " << cost << std::endl;
     } else if (action == "FINDCONNECTEDCOMPONENTS") {
         isstr >> structureType;
@@ -238,6 +456,7 @@ int main() {
     // Initializing data structures
     MinHeap minHeap;
     MaxHeap maxHeap;
+    MinMaxHeap<int> minMaxHeap;
     AVLTree avlTree;
     Graph graph(10);
     HashTable hashTable(1000);
@@ -261,7 +480,7 @@ int main() {
     std::string command;
     while (std::getline(commandsFile, command)) {
         auto start = std::chrono::steady_clock::now();
-        executeCommand(command, minHeap, maxHeap, avlTree, graph, hashTable, outputFile);
+        executeCommand(command, minHeap, maxHeap, minMaxHeap, avlTree, graph, hashTable, outputFile);
         auto end = std::chrono::steady_clock::now();
         // Calculating and writing execution time for each command
         std::chrono::duration<double> duration = end - start;
@@ -1,17 +1,37 @@
 #include "AVLTree.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 // Constructor to initialize the root of the AVL tree
-AVLTree::AVLTree() : root(nullptr) {}
+AVLTree::AVLTree() : root(AVL_NIL) {}
+
+// Move constructor taking over another tree's nodes (a frozen index is not carried over)
+AVLTree::AVLTree(AVLTree&& other) noexcept : nodes(std::move(other.nodes)), root(other.root) {
+    other.root = AVL_NIL;
+    other.thaw();
+}
+
+// Move assignment taking over another tree's nodes
+AVLTree& AVLTree::operator=(AVLTree&& other) noexcept {
+    if (this != &other) {
+        thaw();
+        nodes = std::move(other.nodes);
+        root = other.root;
+        other.root = AVL_NIL;
+        other.thaw();
+    }
+    return *this;
+}
 
 // Returns the height of a node
-int AVLTree::height(AVLNode* node) {
-    return node ? node->height : 0;
+int AVLTree::height(AVLIndex node) {
+    return node != AVL_NIL ? nodes[node].height : 0;
 }
 
 // Returns the balance factor of a node
-int AVLTree::getBalance(AVLNode* node) {
-    return node ? height(node->left) - height(node->right) : 0;
+int AVLTree::getBalance(AVLIndex node) {
+    return node != AVL_NIL ? height(nodes[node].left) - height(nodes[node].right) : 0;
 }
 
 // Returns the maximum of two integers
@@ -19,63 +39,72 @@ int AVLTree::max(int a, int b) const {
     return (a > b) ? a : b;
 }
 
+// Recomputes the height and subtree size of a node from its children
+void AVLTree::update(AVLIndex node) {
+    nodes[node].height = max(height(nodes[node].left), height(nodes[node].right)) + 1;
+    nodes[node].size = size(nodes[node].left) + size(nodes[node].right) + 1;
+}
+
 // Performs a right rotation around the given node
-AVLNode* AVLTree::rotateRight(AVLNode* y) {
-    AVLNode* x = y->left;
-    AVLNode* T2 = x->right;
+AVLIndex AVLTree::rotateRight(AVLIndex y) {
+    AVLIndex x = nodes[y].left;
+    AVLIndex T2 = nodes[x].right;
 
-    x->right = y;
-    y->left = T2;
+    nodes[x].right = y;
+    nodes[y].left = T2;
 
-    y->height = max(height(y->left), height(y->right)) + 1;
-    x->height = max(height(x->left), height(x->right)) + 1;
+    update(y);
+    update(x);
 
     return x;
 }
 
 // Performs a left rotation around the given node
-AVLNode* AVLTree::rotateLeft(AVLNode* x) {
-    AVLNode* y = x->right;
-    AVLNode* T2 = y->left;
+AVLIndex AVLTree::rotateLeft(AVLIndex x) {
+    AVLIndex y = nodes[x].right;
+    AVLIndex T2 = nodes[y].left;
 
-    y->left = x;
-    x->right = T2;
+    nodes[y].left = x;
+    nodes[x].right = T2;
 
-    x->height = std::max(height(x->left), height(x->right)) + 1;
-    y->height = std::max(height(y->left), height(y->right)) + 1;
+    update(x);
+    update(y);
 
     return y;
 }
 
 // Inserts a key into the AVL tree and returns the new root
-AVLNode* AVLTree::insert(AVLNode* node, int key) {
-    if (!node)
-        return new AVLNode(key);
-
-    if (key < node->key)
-        node->left = insert(node->left, key);
-    else if (key > node->key)
-        node->right = insert(node->right, key);
-    else
+AVLIndex AVLTree::insert(AVLIndex node, int key) {
+    if (node == AVL_NIL)
+        return nodes.allocate(AVLNode(key));
+
+    if (key < nodes[node].key) {
+        AVLIndex left = insert(nodes[node].left, key);
+        nodes[node].left = left;
+    } else if (key > nodes[node].key) {
+        AVLIndex right = insert(nodes[node].right, key);
+        nodes[node].right = right;
+    } else {
         return node;
+    }
 
-    node->height = 1 + std::max(height(node->left), height(node->right));
+    update(node);
 
     int balance = getBalance(node);
 
-    if (balance > 1 && key < node->left->key)
+    if (balance > 1 && key < nodes[nodes[node].left].key)
         return rotateRight(node);
 
-    if (balance < -1 && key > node->right->key)
+    if (balance < -1 && key > nodes[nodes[node].right].key)
         return rotateLeft(node);
 
-    if (balance > 1 && key > node->left->key) {
-        node->left = rotateLeft(node->left);
+    if (balance > 1 && key > nodes[nodes[node].left].key) {
+        nodes[node].left = rotateLeft(nodes[node].left);
         return rotateRight(node);
     }
 
-    if (balance < -1 && key < node->right->key) {
-        node->right = rotateRight(node->right);
+    if (balance < -1 && key < nodes[nodes[node].right].key) {
+        nodes[node].right = rotateRight(nodes[node].right);
         return rotateLeft(node);
     }
 
@@ -84,88 +113,288 @@ AVLNode* AVLTree::insert(AVLNode* node, int key) {
 
 // Inserts a key into the AVL tree
 void AVLTree::insert(int key) {
+    thaw();
     root = insert(root, key);
 }
 
 // Deletes a node from the AVL tree and returns the new root
-AVLNode* AVLTree::deleteNode(AVLNode* node, int key) {
-    if (!node) {
+AVLIndex AVLTree::deleteNode(AVLIndex node, int key) {
+    if (node == AVL_NIL) {
         return node;
     }
 
-    if (key < node->key) {
-        node->left = deleteNode(node->left, key);
-    } else if (key > node->key) {
-        node->right = deleteNode(node->right, key);
+    if (key < nodes[node].key) {
+        AVLIndex left = deleteNode(nodes[node].left, key);
+        nodes[node].left = left;
+    } else if (key > nodes[node].key) {
+        AVLIndex right = deleteNode(nodes[node].right, key);
+        nodes[node].right = right;
     } else {
-        if (!node->left || !node->right) {
-            AVLNode* temp = node->left ? node->left : node->right;
-            if (!temp) {
-                temp = node;
-                node = nullptr;
-            } else {
-                *node = *temp;
-            }
-            delete temp;
+        if (nodes[node].left == AVL_NIL || nodes[node].right == AVL_NIL) {
+            AVLIndex child = nodes[node].left != AVL_NIL ? nodes[node].left : nodes[node].right;
+            nodes.release(node);
+            node = child;
         } else {
-            AVLNode* successor = findMinNode(node->right);
-            node->key = successor->key;
-            node->right = deleteNode(node->right, successor->key);
+            AVLIndex successor = findMinNode(nodes[node].right);
+            nodes[node].key = nodes[successor].key;
+            AVLIndex right = deleteNode(nodes[node].right, nodes[successor].key);
+            nodes[node].right = right;
         }
     }
 
-    if (!node) {
+    if (node == AVL_NIL) {
         return node;
     }
 
-    node->height = 1 + std::max(height(node->left), height(node->right));
+    return rebalance(node);
+}
+
+// Deletes a node from the AVL tree
+void AVLTree::deleteNode(int key) {
+    thaw();
+    root = deleteNode(root, key);
+}
+
+// Restores the AVL property at a node whose subtrees differ in height by at
+// most 2 and returns the subtree's new root
+AVLIndex AVLTree::rebalance(AVLIndex node) {
+    update(node);
 
     int balance = getBalance(node);
 
-    if (balance > 1 && getBalance(node->left) >= 0) {
+    if (balance > 1 && getBalance(nodes[node].left) >= 0) {
         return rotateRight(node);
     }
-    if (balance > 1 && getBalance(node->left) < 0) {
-        node->left = rotateLeft(node->left);
+    if (balance > 1 && getBalance(nodes[node].left) < 0) {
+        nodes[node].left = rotateLeft(nodes[node].left);
         return rotateRight(node);
     }
-    if (balance < -1 && getBalance(node->right) <= 0) {
+    if (balance < -1 && getBalance(nodes[node].right) <= 0) {
         return rotateLeft(node);
     }
-    if (balance < -1 && getBalance(node->right) > 0) {
-        node->right = rotateRight(node->right);
+    if (balance < -1 && getBalance(nodes[node].right) > 0) {
+        nodes[node].right = rotateRight(nodes[node].right);
         return rotateLeft(node);
     }
 
     return node;
 }
 
-// Deletes a node from the AVL tree
-void AVLTree::deleteNode(int key) {
-    root = deleteNode(root, key);
+// Links l, the detached node mid and r into one balanced tree. Every key in l
+// must be below mid's key and every key in r above it. Runs in
+// O(|height(l) - height(r)| + 1).
+AVLIndex AVLTree::joinNodes(AVLIndex l, AVLIndex mid, AVLIndex r) {
+    if (height(l) > height(r) + 1) {
+        AVLIndex right = joinNodes(nodes[l].right, mid, r);
+        nodes[l].right = right;
+        return rebalance(l);
+    }
+    if (height(r) > height(l) + 1) {
+        AVLIndex left = joinNodes(l, mid, nodes[r].left);
+        nodes[r].left = left;
+        return rebalance(r);
+    }
+    nodes[mid].left = l;
+    nodes[mid].right = r;
+    update(mid);
+    return mid;
+}
+
+// Unlinks the minimum node of a subtree into minNode and returns the new subtree root
+AVLIndex AVLTree::detachMin(AVLIndex node, AVLIndex& minNode) {
+    if (nodes[node].left == AVL_NIL) {
+        minNode = node;
+        return nodes[node].right;
+    }
+    AVLIndex left = detachMin(nodes[node].left, minNode);
+    nodes[node].left = left;
+    return rebalance(node);
+}
+
+// Concatenates two subtrees where every key of l is below every key of r
+AVLIndex AVLTree::concat(AVLIndex l, AVLIndex r) {
+    if (l == AVL_NIL) {
+        return r;
+    }
+    if (r == AVL_NIL) {
+        return l;
+    }
+    AVLIndex mid;
+    AVLIndex rest = detachMin(r, mid);
+    return joinNodes(l, mid, rest);
+}
+
+// Splits a subtree into the keys below key (less) and the rest (notLess)
+void AVLTree::splitNode(AVLIndex node, int key, AVLIndex& less, AVLIndex& notLess) {
+    if (node == AVL_NIL) {
+        less = AVL_NIL;
+        notLess = AVL_NIL;
+        return;
+    }
+    AVLIndex left = nodes[node].left;
+    AVLIndex right = nodes[node].right;
+    if (key <= nodes[node].key) {
+        AVLIndex middle;
+        splitNode(left, key, less, middle);
+        notLess = joinNodes(middle, node, right);
+    } else {
+        AVLIndex middle;
+        splitNode(right, key, middle, notLess);
+        less = joinNodes(left, node, middle);
+    }
+}
+
+// Builds a perfectly balanced subtree from sorted, distinct keys in O(n)
+AVLIndex AVLTree::buildSorted(const int* keys, int count) {
+    if (count <= 0) {
+        return AVL_NIL;
+    }
+    int mid = count / 2;
+    AVLIndex node = nodes.allocate(AVLNode(keys[mid]));
+    AVLIndex left = buildSorted(keys, mid);
+    AVLIndex right = buildSorted(keys + mid + 1, count - mid - 1);
+    nodes[node].left = left;
+    nodes[node].right = right;
+    update(node);
+    return node;
 }
 
-// Builds the AVL tree from an array of elements
+// Appends the keys of a subtree in sorted order
+void AVLTree::collectKeys(AVLIndex node, std::vector<int>& keys) const {
+    if (node != AVL_NIL) {
+        collectKeys(nodes[node].left, keys);
+        keys.push_back(nodes[node].key);
+        collectKeys(nodes[node].right, keys);
+    }
+}
+
+// Returns every node of a subtree to the arena
+void AVLTree::releaseSubtree(AVLIndex node) {
+    if (node != AVL_NIL) {
+        releaseSubtree(nodes[node].left);
+        releaseSubtree(nodes[node].right);
+        nodes.release(node);
+    }
+}
+
+// Rebuilds the AVL tree from an array of elements, releasing the old nodes in
+// bulk. Input that is already sorted skips the sort, and the balanced tree is
+// then built bottom-up in O(n) instead of n rebalancing inserts.
 void AVLTree::buildTree(int* elements, int size) {
-    for (int i = 0; i < size; ++i) {
-        insert(elements[i]);
+    clear();
+    std::vector<int> keys(elements, elements + size);
+    if (!std::is_sorted(keys.begin(), keys.end())) {
+        std::sort(keys.begin(), keys.end());
+    }
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    root = buildSorted(keys.data(), static_cast<int>(keys.size()));
+}
+
+// Moves every key of other into this tree and leaves other empty. When the
+// two key ranges do not overlap, the smaller tree's nodes are copied into this
+// tree's arena and the trees are joined, O(min(n, m) + log n) in total;
+// overlapping trees are merged in linear time and rebuilt balanced. Nothing is
+// reinserted key by key.
+void AVLTree::join(AVLTree& other) {
+    if (this == &other || other.root == AVL_NIL) {
+        return;
+    }
+    thaw();
+    if (size(root) < other.size(other.root)) {
+        nodes.swap(other.nodes);
+        std::swap(root, other.root);
+    }
+    AVLIndex adopted = copyPreorder(other.nodes, other.root, nodes);
+    other.clear();
+    if (adopted == AVL_NIL) {
+        return;
+    }
+
+    AVLIndex low = findMinNode(root);
+    AVLIndex high = findMaxNode(root);
+    AVLIndex adoptedLow = findMinNode(adopted);
+    AVLIndex adoptedHigh = findMaxNode(adopted);
+    if (nodes[high].key < nodes[adoptedLow].key) {
+        root = concat(root, adopted);
+    } else if (nodes[adoptedHigh].key < nodes[low].key) {
+        root = concat(adopted, root);
+    } else {
+        std::vector<int> mine;
+        std::vector<int> theirs;
+        collectKeys(root, mine);
+        collectKeys(adopted, theirs);
+        std::vector<int> merged;
+        merged.reserve(mine.size() + theirs.size());
+        std::set_union(mine.begin(), mine.end(), theirs.begin(), theirs.end(), std::back_inserter(merged));
+        clear();
+        root = buildSorted(merged.data(), static_cast<int>(merged.size()));
+    }
+}
+
+// Keeps the keys below key and returns a new tree holding the rest. The split
+// itself is O(log n); afterwards the smaller half is copied into a fresh arena.
+AVLTree AVLTree::split(int key) {
+    thaw();
+    AVLIndex less;
+    AVLIndex notLess;
+    splitNode(root, key, less, notLess);
+
+    AVLTree result;
+    if (size(notLess) > size(less)) {
+        result.nodes.swap(nodes);
+        result.root = notLess;
+        root = copyPreorder(result.nodes, less, nodes);
+        result.releaseSubtree(less);
+    } else {
+        result.root = copyPreorder(nodes, notLess, result.nodes);
+        releaseSubtree(notLess);
+        root = less;
+    }
+    return result;
+}
+
+// Removes every key and frees all nodes at once
+void AVLTree::clear() {
+    thaw();
+    nodes.clear();
+    root = AVL_NIL;
+}
+
+// Copies a subtree of source into target in depth-first (preorder) order and returns its new index
+AVLIndex AVLTree::copyPreorder(const NodeArena<AVLNode>& source, AVLIndex node, NodeArena<AVLNode>& target) {
+    if (node == AVL_NIL) {
+        return AVL_NIL;
     }
+    AVLIndex copy = target.allocate(source[node]);
+    AVLIndex left = copyPreorder(source, source[node].left, target);
+    AVLIndex right = copyPreorder(source, source[node].right, target);
+    target[copy].left = left;
+    target[copy].right = right;
+    return copy;
 }
 
-// Returns the size of the AVL tree from node to leaves
-int AVLTree::size(AVLNode* node) const {
-    return node ? 1 + size(node->left) + size(node->right) : 0;
+// Lays the nodes out again in depth-first order, so a search path walks
+// mostly forward through memory and freed slots are squeezed out
+void AVLTree::compact() {
+    NodeArena<AVLNode> packed;
+    root = copyPreorder(nodes, root, packed);
+    nodes = std::move(packed);
+}
+
+// Returns the number of keys in the subtree rooted at node
+int AVLTree::size(AVLIndex node) const {
+    return node != AVL_NIL ? nodes[node].size : 0;
 }
 
 // Returns the total size of the AVL tree (from root to leaves)
 int AVLTree::getSize() const { return size(root); }
 
 // Prints an AVL node
-void AVLTree::printAVLNode(AVLNode* node, std::ofstream& output) {
-    if (node) {
-        printAVLNode(node->left, output);
-        output << node->key << " ";
-        printAVLNode(node->right, output);
+void AVLTree::printAVLNode(AVLIndex node, std::ofstream& output) {
+    if (node != AVL_NIL) {
+        printAVLNode(nodes[node].left, output);
+        output << nodes[node].key << " ";
+        printAVLNode(nodes[node].right, output);
     }
 }
 
@@ -177,35 +406,207 @@ void AVLTree::printAVLTree(std::ofstream& output) {
 }
 
 // Finds the minimum node in the AVL tree
-AVLNode* AVLTree::findMinNode(AVLNode* node) const {
-    AVLNode* current = node;
-    while (current && current->left) {
-        current = current->left;
+AVLIndex AVLTree::findMinNode(AVLIndex node) const {
+    AVLIndex current = node;
+    while (current != AVL_NIL && nodes[current].left != AVL_NIL) {
+        current = nodes[current].left;
+    }
+    return current;
+}
+
+// Finds the maximum node in the AVL tree
+AVLIndex AVLTree::findMaxNode(AVLIndex node) const {
+    AVLIndex current = node;
+    while (current != AVL_NIL && nodes[current].right != AVL_NIL) {
+        current = nodes[current].right;
     }
     return current;
 }
 
 // Finds the minimum key in the AVL tree
 int AVLTree::findMin() const {
-    AVLNode* minNode = findMinNode(root);
-    return minNode ? minNode->key : -1;
+    AVLIndex minNode = findMinNode(root);
+    return minNode != AVL_NIL ? nodes[minNode].key : -1;
+}
+
+// Counts the keys below key (or not above it when inclusive)
+int AVLTree::countLess(int key, bool inclusive) const {
+    int count = 0;
+    AVLIndex node = root;
+    while (node != AVL_NIL) {
+        if (key > nodes[node].key || (inclusive && key == nodes[node].key)) {
+            count += size(nodes[node].left) + 1;
+            node = nodes[node].right;
+        } else {
+            node = nodes[node].left;
+        }
+    }
+    return count;
+}
+
+// Returns the number of keys smaller than key, i.e. its 0-based position if present
+int AVLTree::rank(int key) const {
+    return countLess(key, false);
+}
+
+// Returns the key at 0-based position k in sorted order, or -1 if k is out of range
+int AVLTree::select(int k) const {
+    if (k < 0 || k >= size(root)) {
+        return -1;
+    }
+    AVLIndex node = root;
+    while (true) {
+        int leftSize = size(nodes[node].left);
+        if (k < leftSize) {
+            node = nodes[node].left;
+        } else if (k > leftSize) {
+            k -= leftSize + 1;
+            node = nodes[node].right;
+        } else {
+            return nodes[node].key;
+        }
+    }
+}
+
+// Counts the keys in the closed range [lo, hi]
+int AVLTree::countInRange(int lo, int hi) const {
+    if (lo > hi) {
+        return 0;
+    }
+    return countLess(hi, true) - countLess(lo, false);
+}
+
+// Returns the lower median key, or -1 if the tree is empty
+int AVLTree::median() const {
+    return select((size(root) - 1) / 2);
+}
+
+// Pushes node and then, following left (or right) links, the rest of its leftmost (rightmost) path
+void AVLTree::Iterator::descend(AVLIndex node, bool leftmost) {
+    while (node != AVL_NIL) {
+        push(node);
+        node = leftmost ? tree->nodes[node].left : tree->nodes[node].right;
+    }
+}
+
+// Advances to the next larger key
+AVLTree::Iterator& AVLTree::Iterator::operator++() {
+    AVLIndex node = path[depth - 1];
+    if (tree->nodes[node].right != AVL_NIL) {
+        descend(tree->nodes[node].right, true);
+        return *this;
+    }
+    // Climb until we leave a left subtree
+    --depth;
+    while (depth > 0 && tree->nodes[path[depth - 1]].right == node) {
+        node = path[--depth];
+    }
+    return *this;
+}
+
+// Moves to the next smaller key; decrementing end() yields the largest key
+AVLTree::Iterator& AVLTree::Iterator::operator--() {
+    if (depth == 0) {
+        descend(tree->root, false);
+        return *this;
+    }
+    AVLIndex node = path[depth - 1];
+    if (tree->nodes[node].left != AVL_NIL) {
+        descend(tree->nodes[node].left, false);
+        return *this;
+    }
+    // Climb until we leave a right subtree
+    --depth;
+    while (depth > 0 && tree->nodes[path[depth - 1]].left == node) {
+        node = path[--depth];
+    }
+    return *this;
+}
+
+// Returns an iterator to the smallest key
+AVLTree::Iterator AVLTree::begin() const {
+    Iterator it(this);
+    it.descend(root, true);
+    return it;
+}
+
+// Returns the past-the-end iterator
+AVLTree::Iterator AVLTree::end() const {
+    return Iterator(this);
+}
+
+// Returns an iterator to the first key not below key
+AVLTree::Iterator AVLTree::lower_bound(int key) const {
+    Iterator it(this);
+    int found = 0;
+    AVLIndex node = root;
+    while (node != AVL_NIL) {
+        it.push(node);
+        if (nodes[node].key < key) {
+            node = nodes[node].right;
+        } else {
+            found = it.depth;
+            node = nodes[node].left;
+        }
+    }
+    it.depth = found;
+    return it;
+}
+
+// Returns an iterator to the first key above key
+AVLTree::Iterator AVLTree::upper_bound(int key) const {
+    Iterator it(this);
+    int found = 0;
+    AVLIndex node = root;
+    while (node != AVL_NIL) {
+        it.push(node);
+        if (nodes[node].key <= key) {
+            node = nodes[node].right;
+        } else {
+            found = it.depth;
+            node = nodes[node].left;
+        }
+    }
+    it.depth = found;
+    return it;
 }
 
 // Searches for a key in the AVL tree
-AVLNode* AVLTree::searchNode(AVLNode* node, int key) const {
-    if (!node || node->key == key) {
-        return node;
+AVLIndex AVLTree::searchNode(AVLIndex node, int key) const {
+    while (node != AVL_NIL && nodes[node].key != key) {
+        node = key < nodes[node].key ? nodes[node].left : nodes[node].right;
     }
+    return node;
+}
 
-    if (key < node->key) {
-        return searchNode(node->left, key);
-    } else {
-        return searchNode(node->right, key);
+// Checks if a key is in the AVL tree, through the frozen index while it is valid
+bool AVLTree::contains(int key) const {
+    if (frozen.isBuilt()) {
+        return frozen.contains(key);
     }
+    return searchNode(root, key) != AVL_NIL;
 }
 
 // Searches for a key in the AVL tree
 std::string AVLTree::search(int key) const {
-    AVLNode* foundNode = searchNode(root, key);
-    return foundNode ? "SUCCESS" : "FAILURE";
+    return contains(key) ? "SUCCESS" : "FAILURE";
+}
+
+// Exports the current keys into a read-only Eytzinger index that serves
+// search until the next mutation
+void AVLTree::freeze() {
+    std::vector<int> keys;
+    keys.reserve(size(root));
+    collectKeys(root, keys);
+    frozen.build(keys.data(), keys.size());
+}
+
+// Checks if searches are currently served by the frozen index
+bool AVLTree::isFrozen() const {
+    return frozen.isBuilt();
+}
+
+// Drops the frozen index after a mutation
+void AVLTree::thaw() {
+    frozen.clear();
 }
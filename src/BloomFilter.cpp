@@ -0,0 +1,78 @@
+#include "BloomFilter.h"
+#include <cmath>
+
+namespace {
+
+// Picks the bit for the i-th probe from 9-bit slices of a remixed hash
+inline int probeBit(uint64_t& bits, int i) {
+    if (i % 7 == 0) {
+        bits = bits * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull;
+    }
+    return static_cast<int>((bits >> (9 * (i % 7))) & 511);
+}
+
+} // namespace
+
+// Constructor to create an empty filter that rejects nothing until reset
+BloomFilter::BloomFilter() : probes(0) {}
+
+// Sizes the filter for expectedKeys at the given false-positive rate, but
+// never above maxBytes (0 means no limit), and empties it
+void BloomFilter::reset(std::size_t expectedKeys, double falsePositiveRate, std::size_t maxBytes) {
+    if (falsePositiveRate <= 0 || falsePositiveRate >= 1) {
+        falsePositiveRate = 0.01;
+    }
+    // Optimal bits per key for a classic filter, plus a fifth for the uneven
+    // load that confining each key to one block causes
+    double bitsPerKey = -std::log2(falsePositiveRate) / std::log(2.0) * 1.2;
+    std::size_t blockCount = static_cast<std::size_t>(std::ceil(bitsPerKey * (expectedKeys + 1) / 512));
+    if (maxBytes != 0 && blockCount * sizeof(Block) > maxBytes) {
+        blockCount = maxBytes / sizeof(Block);
+    }
+    if (blockCount == 0) {
+        blockCount = 1;
+    }
+    double actualBitsPerKey = 512.0 * blockCount / (expectedKeys + 1);
+    probes = static_cast<int>(std::lround(actualBitsPerKey * std::log(2.0)));
+    probes = probes < 1 ? 1 : (probes > 16 ? 16 : probes);
+    blocks.assign(blockCount, Block());
+}
+
+// Releases the filter's memory
+void BloomFilter::clear() {
+    std::vector<Block>().swap(blocks);
+    probes = 0;
+}
+
+// Returns the block a hash maps to (bits 32 and up, scaled to the block count)
+std::size_t BloomFilter::blockIndex(uint64_t hash) const {
+    return ((hash >> 32) * blocks.size()) >> 32;
+}
+
+// Records a key's hash
+void BloomFilter::add(uint64_t hash) {
+    Block& block = blocks[blockIndex(hash)];
+    uint64_t bits = hash;
+    for (int i = 0; i < probes; ++i) {
+        int bit = probeBit(bits, i);
+        block.words[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+}
+
+// Checks whether a hash may have been added
+bool BloomFilter::mayContain(uint64_t hash) const {
+    const Block& block = blocks[blockIndex(hash)];
+    uint64_t bits = hash;
+    for (int i = 0; i < probes; ++i) {
+        int bit = probeBit(bits, i);
+        if (!(block.words[bit / 64] & (uint64_t(1) << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Starts loading the block a hash maps to
+void BloomFilter::prefetch(uint64_t hash) const {
+    __builtin_prefetch(&blocks[blockIndex(hash)]);
+}
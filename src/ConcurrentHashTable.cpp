@@ -0,0 +1,265 @@
+#include "ConcurrentHashTable.h"
+#include <cstring>
+#include <functional>
+#include <thread>
+
+// Constructor to spread room for size keys over shardCount shards (rounded up to a power of two)
+ConcurrentHashTable::ConcurrentHashTable(int size, int shardCount) : shardBits(0), globalEpoch(1) {
+    while ((1 << shardBits) < shardCount) {
+        ++shardBits;
+    }
+    shards.reset(new Shard[1 << shardBits]);
+
+    int perShard = size >> shardBits;
+    int capacity = GroupSize;
+    while (capacity - capacity / 8 <= perShard) {
+        capacity *= 2;
+    }
+    for (int i = 0; i < (1 << shardBits); ++i) {
+        shards[i].live.reset(new Arrays(capacity));
+        shards[i].arrays.store(shards[i].live.get());
+        shards[i].growthLeft = capacity - capacity / 8;
+    }
+}
+
+// Allocates empty control bytes and slots for capacity slots
+ConcurrentHashTable::Arrays::Arrays(int capacity)
+    : capacity(capacity), control(new std::atomic<uint64_t>[capacity / 8]), slots(new std::atomic<int>[capacity]) {
+    uint64_t empty;
+    std::memset(&empty, static_cast<uint8_t>(swissEmpty), sizeof(empty));
+    for (int i = 0; i < capacity / 8; ++i) {
+        control[i].store(empty, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < capacity; ++i) {
+        slots[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Returns the shard owning a hash; its top bits pick the shard, the low bits the slot
+ConcurrentHashTable::Shard& ConcurrentHashTable::shardFor(uint64_t hash) const {
+    return shards[shardBits ? hash >> (64 - shardBits) : 0];
+}
+
+// Copies the control bytes of one group into an aligned buffer
+void ConcurrentHashTable::loadGroup(const Arrays& arrays, uint64_t group, int8_t* bytes) {
+    uint64_t words[2] = {arrays.control[2 * group].load(std::memory_order_relaxed),
+                         arrays.control[2 * group + 1].load(std::memory_order_relaxed)};
+    std::memcpy(bytes, words, sizeof(words));
+}
+
+// Sets one control byte (writer only, under the shard lock)
+void ConcurrentHashTable::storeControl(Arrays& arrays, int slot, int8_t value) {
+    std::atomic<uint64_t>& word = arrays.control[slot / 8];
+    uint64_t bytes = word.load(std::memory_order_relaxed);
+    int shift = (slot % 8) * 8;
+    bytes = (bytes & ~(uint64_t(0xFF) << shift)) | (uint64_t(static_cast<uint8_t>(value)) << shift);
+    word.store(bytes, std::memory_order_relaxed);
+}
+
+// Returns the slot holding key, or -1. complete is false when the probe gave
+// up after visiting every group, which only happens on a torn read.
+int ConcurrentHashTable::findSlot(const Arrays& arrays, int key, uint64_t hash, bool& complete) {
+    alignas(16) int8_t bytes[GroupSize];
+    int8_t tag = static_cast<int8_t>(hash & 0x7F);
+    uint64_t mask = arrays.capacity / GroupSize - 1;
+    uint64_t group = (hash >> 7) & mask;
+    complete = true;
+    for (uint64_t step = 1; step <= mask + 1; ++step) {
+        loadGroup(arrays, group, bytes);
+        for (uint32_t match = swissMatch(bytes, tag); match; match &= match - 1) {
+            int slot = static_cast<int>(group * GroupSize) + __builtin_ctz(match);
+            if (arrays.slots[slot].load(std::memory_order_relaxed) == key) {
+                return slot;
+            }
+        }
+        if (swissMatch(bytes, swissEmpty)) {
+            return -1;
+        }
+        group = (group + step) & mask;
+    }
+    complete = false;
+    return -1;
+}
+
+// Returns the first empty or deleted slot on a hash's probe sequence
+int ConcurrentHashTable::freeSlot(const Arrays& arrays, uint64_t hash) {
+    alignas(16) int8_t bytes[GroupSize];
+    uint64_t mask = arrays.capacity / GroupSize - 1;
+    uint64_t group = (hash >> 7) & mask;
+    for (uint64_t step = 1;; ++step) {
+        loadGroup(arrays, group, bytes);
+        uint32_t free = swissMatchFree(bytes);
+        if (free) {
+            return static_cast<int>(group * GroupSize) + __builtin_ctz(free);
+        }
+        group = (group + step) & mask;
+    }
+}
+
+// Replaces a shard's arrays with a rebuilt copy of newCapacity slots. The old
+// arrays are never written again, so readers still on them see a consistent
+// (if stale) shard; the sequence bump makes them retry.
+void ConcurrentHashTable::rehash(Shard& shard, int newCapacity) {
+    const Arrays& old = *shard.arrays.load(std::memory_order_relaxed);
+    std::unique_ptr<Arrays> fresh(new Arrays(newCapacity));
+    int growthLeft = newCapacity - newCapacity / 8;
+    alignas(16) int8_t bytes[GroupSize];
+    for (uint64_t group = 0; group < static_cast<uint64_t>(old.capacity / GroupSize); ++group) {
+        loadGroup(old, group, bytes);
+        for (int i = 0; i < GroupSize; ++i) {
+            if (bytes[i] >= 0) {
+                int key = old.slots[group * GroupSize + i].load(std::memory_order_relaxed);
+                uint64_t hash = swissHash(key);
+                int slot = freeSlot(*fresh, hash);
+                storeControl(*fresh, slot, static_cast<int8_t>(hash & 0x7F));
+                fresh->slots[slot].store(key, std::memory_order_relaxed);
+                --growthLeft;
+            }
+        }
+    }
+
+    uint32_t sequence = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    shard.arrays.store(fresh.get());
+    shard.sequence.store(sequence + 2, std::memory_order_release);
+    shard.growthLeft = growthLeft;
+
+    // Readers that may still be on the old arrays announced an epoch no
+    // newer than the one current before this point
+    shard.live.swap(fresh);
+    shard.retired.push_back(RetiredArrays{globalEpoch.fetch_add(1), std::move(fresh)});
+    reclaim(shard);
+}
+
+// Frees a shard's retired arrays that no lookup in progress can still reach.
+// A lookup that announced epoch e loaded the shard's arrays after epoch e
+// began, so it cannot see arrays retired under an epoch below e.
+void ConcurrentHashTable::reclaim(Shard& shard) {
+    uint64_t oldest = globalEpoch.load();
+    for (int i = 0; i < MaxReaders; ++i) {
+        uint64_t epoch = readers[i].epoch.load();
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    while (!shard.retired.empty() && shard.retired.front().epoch < oldest) {
+        shard.retired.pop_front();
+    }
+}
+
+// Claims a reader slot, starting from one picked by the thread's id, and
+// announces the current epoch in it
+int ConcurrentHashTable::enterRead() const {
+    thread_local int preferred = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % MaxReaders);
+    while (true) {
+        for (int i = 0; i < MaxReaders; ++i) {
+            int slot = (preferred + i) % MaxReaders;
+            uint64_t expected = 0;
+            if (readers[slot].epoch.compare_exchange_strong(expected, globalEpoch.load())) {
+                return slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+// Releases a reader slot
+void ConcurrentHashTable::exitRead(int slot) const {
+    readers[slot].epoch.store(0, std::memory_order_release);
+}
+
+// Inserts a key; returns false if it was already present
+bool ConcurrentHashTable::insert(int key) {
+    uint64_t hash = swissHash(key);
+    Shard& shard = shardFor(hash);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    bool complete;
+    if (findSlot(*shard.arrays.load(std::memory_order_relaxed), key, hash, complete) >= 0) {
+        return false;
+    }
+    if (shard.growthLeft == 0) {
+        // Mostly tombstones: clean up at the same size, otherwise double
+        int capacity = shard.arrays.load(std::memory_order_relaxed)->capacity;
+        int limit = capacity - capacity / 8;
+        rehash(shard, shard.count.load(std::memory_order_relaxed) * 2 < limit ? capacity : capacity * 2);
+    }
+
+    Arrays& arrays = *shard.arrays.load(std::memory_order_relaxed);
+    int slot = freeSlot(arrays, hash);
+    alignas(16) int8_t bytes[GroupSize];
+    loadGroup(arrays, slot / GroupSize, bytes);
+    if (bytes[slot % GroupSize] == swissEmpty) {
+        --shard.growthLeft;
+    }
+
+    uint32_t sequence = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    arrays.slots[slot].store(key, std::memory_order_relaxed);
+    storeControl(arrays, slot, static_cast<int8_t>(hash & 0x7F));
+    shard.sequence.store(sequence + 2, std::memory_order_release);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Removes a key; returns false if it was not present
+bool ConcurrentHashTable::erase(int key) {
+    uint64_t hash = swissHash(key);
+    Shard& shard = shardFor(hash);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    Arrays& arrays = *shard.arrays.load(std::memory_order_relaxed);
+    bool complete;
+    int slot = findSlot(arrays, key, hash, complete);
+    if (slot < 0) {
+        return false;
+    }
+    // A group with an empty slot never made a probe move past it
+    alignas(16) int8_t bytes[GroupSize];
+    loadGroup(arrays, slot / GroupSize, bytes);
+    int8_t marker = swissMatch(bytes, swissEmpty) ? swissEmpty : swissDeleted;
+    if (marker == swissEmpty) {
+        ++shard.growthLeft;
+    }
+
+    uint32_t sequence = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    storeControl(arrays, slot, marker);
+    shard.sequence.store(sequence + 2, std::memory_order_release);
+    shard.count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Checks if a key is in the table without locking. The read is retried
+// whenever a writer touched the shard while it was in progress.
+bool ConcurrentHashTable::contains(int key) const {
+    uint64_t hash = swissHash(key);
+    const Shard& shard = shardFor(hash);
+    int reader = enterRead();
+    while (true) {
+        uint32_t before = shard.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        const Arrays& arrays = *shard.arrays.load();
+        bool complete;
+        bool found = findSlot(arrays, key, hash, complete) >= 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (complete && shard.sequence.load(std::memory_order_relaxed) == before) {
+            exitRead(reader);
+            return found;
+        }
+    }
+}
+
+// Returns the number of keys (a snapshot while other threads run)
+int ConcurrentHashTable::getSize() const {
+    int total = 0;
+    for (int i = 0; i < (1 << shardBits); ++i) {
+        total += shards[i].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
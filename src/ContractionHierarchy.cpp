@@ -0,0 +1,366 @@
+#include "ContractionHierarchy.h"
+#include "CustomQueue.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+namespace {
+
+// Vertices a witness search may settle before giving up and adding the
+// shortcut. Estimating a vertex's priority uses the smaller limit: it only
+// orders the contraction, so a few spurious shortcuts in the count are cheap.
+const int WitnessSettleLimit = 64;
+const int EstimateSettleLimit = 16;
+
+struct WorkArc {
+    int to;
+    int weight;
+    int middle;
+};
+
+// Mutable graph used while contracting. Contracted vertices are removed from
+// their neighbors' lists, so each list only reaches uncontracted vertices.
+struct Contractor {
+    std::vector<std::vector<WorkArc>> adjacency;
+    std::vector<char> contracted;
+    std::vector<int> witnessDist;
+    std::vector<unsigned> witnessSeen;
+    std::vector<unsigned> witnessTarget;
+    unsigned witnessStamp = 0;
+    CustomQueue<std::pair<int, int>> queue;
+
+    // Bounded Dijkstra from arcs[first].to avoiding skip, stopping once every
+    // later target in arcs is settled; fills witnessDist for the vertices it
+    // reaches within limit
+    void witnessSearch(const std::vector<WorkArc>& arcs, std::size_t first, int skip, int limit, int settleLimit) {
+        ++witnessStamp;
+        int pending = 0;
+        for (std::size_t j = first + 1; j < arcs.size(); ++j) {
+            if (witnessTarget[arcs[j].to] != witnessStamp) {
+                witnessTarget[arcs[j].to] = witnessStamp;
+                ++pending;
+            }
+        }
+        queue.clear();
+        int source = arcs[first].to;
+        witnessDist[source] = 0;
+        witnessSeen[source] = witnessStamp;
+        queue.push({0, source});
+        int settled = 0;
+        while (!queue.isEmpty() && settled < settleLimit && pending > 0) {
+            int d = queue.front().first;
+            int u = queue.front().second;
+            queue.pop();
+            if (d > witnessDist[u]) {
+                continue;
+            }
+            ++settled;
+            if (witnessTarget[u] == witnessStamp) {
+                --pending;
+            }
+            for (const WorkArc& arc : adjacency[u]) {
+                if (arc.to == skip) {
+                    continue;
+                }
+                int candidate = d + arc.weight;
+                if (candidate > limit) {
+                    continue;
+                }
+                if (witnessSeen[arc.to] != witnessStamp || candidate < witnessDist[arc.to]) {
+                    witnessSeen[arc.to] = witnessStamp;
+                    witnessDist[arc.to] = candidate;
+                    queue.push({candidate, arc.to});
+                }
+            }
+        }
+    }
+
+    // Checks whether a witness path from the last search reaches target within length
+    bool hasWitness(int target, int length) const {
+        return witnessSeen[target] == witnessStamp && witnessDist[target] <= length;
+    }
+
+    // Collects (or just counts) the shortcuts contracting v needs
+    int shortcuts(int v, std::vector<std::pair<std::pair<int, int>, int>>* added) {
+        const std::vector<WorkArc>& arcs = adjacency[v];
+        int count = 0;
+        // The last arc has no later partner; a zero limit still needs its
+        // search, since zero-weight edges make zero-length shortcuts
+        for (std::size_t i = 0; i + 1 < arcs.size(); ++i) {
+            int limit = 0;
+            for (std::size_t j = i + 1; j < arcs.size(); ++j) {
+                limit = std::max(limit, arcs[i].weight + arcs[j].weight);
+            }
+            witnessSearch(arcs, i, v, limit, added ? WitnessSettleLimit : EstimateSettleLimit);
+            for (std::size_t j = i + 1; j < arcs.size(); ++j) {
+                int length = arcs[i].weight + arcs[j].weight;
+                if (!hasWitness(arcs[j].to, length)) {
+                    ++count;
+                    if (added) {
+                        added->push_back({{arcs[i].to, arcs[j].to}, length});
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    // Adds or shortens the edge between u and w (in both lists)
+    void addShortcut(int u, int w, int weight, int middle) {
+        for (WorkArc& arc : adjacency[u]) {
+            if (arc.to == w) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (WorkArc& back : adjacency[w]) {
+                        if (back.to == u) {
+                            back.weight = weight;
+                            back.middle = middle;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        adjacency[u].push_back(WorkArc{w, weight, middle});
+        adjacency[w].push_back(WorkArc{u, weight, middle});
+    }
+};
+
+} // namespace
+
+// Constructor to create an empty, unbuilt hierarchy
+ContractionHierarchy::ContractionHierarchy() : shortcutCount(0), built(false), stamp(0) {}
+
+// Builds the hierarchy for an undirected graph in CSR form (each edge listed
+// from both endpoints). Parallel edges keep their lightest weight; self-loops
+// are ignored.
+void ContractionHierarchy::build(int vertices, const int* offsets, const int* neighbors, const int* weights) {
+    clear();
+
+    Contractor contractor;
+    contractor.adjacency.resize(vertices);
+    contractor.contracted.assign(vertices, 0);
+    contractor.witnessDist.assign(vertices, 0);
+    contractor.witnessSeen.assign(vertices, 0);
+    contractor.witnessTarget.assign(vertices, 0);
+    for (int v = 0; v < vertices; ++v) {
+        for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+            if (neighbors[e] != v) {
+                contractor.addShortcut(v, neighbors[e], weights[e], -1);
+            }
+        }
+    }
+
+    // Importance: twice the shortcuts added minus the edges removed, plus
+    // contracted neighbors and the depth of the hierarchy below the vertex,
+    // so that contraction spreads evenly over the graph
+    std::vector<int> contractedNeighbors(vertices, 0);
+    std::vector<int> level(vertices, 0);
+    std::vector<int> priority(vertices);
+    CustomQueue<std::pair<int, int>> order;
+    auto importance = [&](int v) {
+        return 2 * (contractor.shortcuts(v, nullptr) - static_cast<int>(contractor.adjacency[v].size())) + contractedNeighbors[v] + level[v];
+    };
+    for (int v = 0; v < vertices; ++v) {
+        priority[v] = importance(v);
+        order.push({priority[v], v});
+    }
+
+    std::vector<std::vector<Arc>> upward(vertices);
+    std::vector<std::pair<std::pair<int, int>, int>> added;
+    while (!order.isEmpty()) {
+        int v = order.front().second;
+        int queued = order.front().first;
+        order.pop();
+        if (contractor.contracted[v] || queued != priority[v]) {
+            continue;
+        }
+        // Lazy update: the priority may have grown since it was queued
+        priority[v] = importance(v);
+        if (!order.isEmpty() && priority[v] > order.front().first) {
+            order.push({priority[v], v});
+            continue;
+        }
+
+        added.clear();
+        contractor.shortcuts(v, &added);
+        for (const auto& shortcut : added) {
+            contractor.addShortcut(shortcut.first.first, shortcut.first.second, shortcut.second, v);
+        }
+        shortcutCount += static_cast<int>(added.size());
+
+        contractor.contracted[v] = 1;
+        for (const WorkArc& arc : contractor.adjacency[v]) {
+            upward[v].push_back(Arc{arc.to, arc.weight, arc.middle});
+            std::vector<WorkArc>& back = contractor.adjacency[arc.to];
+            for (std::size_t i = 0; i < back.size(); ++i) {
+                if (back[i].to == v) {
+                    back[i] = back.back();
+                    back.pop_back();
+                    break;
+                }
+            }
+            ++contractedNeighbors[arc.to];
+            level[arc.to] = std::max(level[arc.to], level[v] + 1);
+            priority[arc.to] = importance(arc.to);
+            order.push({priority[arc.to], arc.to});
+        }
+        std::vector<WorkArc>().swap(contractor.adjacency[v]);
+    }
+
+    upOffsets.assign(vertices + 1, 0);
+    for (int v = 0; v < vertices; ++v) {
+        upOffsets[v + 1] = upOffsets[v] + static_cast<int>(upward[v].size());
+    }
+    upArcs.reserve(upOffsets[vertices]);
+    for (int v = 0; v < vertices; ++v) {
+        upArcs.insert(upArcs.end(), upward[v].begin(), upward[v].end());
+    }
+    for (int side = 0; side < 2; ++side) {
+        dist[side].assign(vertices, 0);
+        parentArc[side].assign(vertices, -1);
+        seen[side].assign(vertices, 0);
+    }
+    stamp = 0;
+    built = true;
+}
+
+// Drops the hierarchy
+void ContractionHierarchy::clear() {
+    std::vector<int>().swap(upOffsets);
+    std::vector<Arc>().swap(upArcs);
+    for (int side = 0; side < 2; ++side) {
+        std::vector<int>().swap(dist[side]);
+        std::vector<int>().swap(parentArc[side]);
+        std::vector<unsigned>().swap(seen[side]);
+    }
+    shortcutCount = 0;
+    built = false;
+}
+
+// Bidirectional upward Dijkstra. Returns the distance (INT_MAX when
+// unreachable) and the vertex where the two searches meet.
+int ContractionHierarchy::search(int source, int destination, int& meet) {
+    if (++stamp == 0) {
+        for (int side = 0; side < 2; ++side) {
+            std::fill(seen[side].begin(), seen[side].end(), 0);
+        }
+        stamp = 1;
+    }
+    CustomQueue<std::pair<int, int>> queue[2];
+    int endpoints[2] = {source, destination};
+    for (int side = 0; side < 2; ++side) {
+        dist[side][endpoints[side]] = 0;
+        parentArc[side][endpoints[side]] = -1;
+        seen[side][endpoints[side]] = stamp;
+        queue[side].push({0, endpoints[side]});
+    }
+
+    int best = INT_MAX;
+    meet = -1;
+    while (true) {
+        // Advance the side with the smaller tentative distance; a side is
+        // finished once its smallest key cannot improve on best
+        bool open[2];
+        for (int side = 0; side < 2; ++side) {
+            open[side] = !queue[side].isEmpty() && queue[side].front().first < best;
+        }
+        if (!open[0] && !open[1]) {
+            break;
+        }
+        int side = !open[1] || (open[0] && queue[0].front().first <= queue[1].front().first) ? 0 : 1;
+        int d = queue[side].front().first;
+        int u = queue[side].front().second;
+        queue[side].pop();
+        if (d > dist[side][u]) {
+            continue;
+        }
+        if (seen[1 - side][u] == stamp && d + dist[1 - side][u] < best) {
+            best = d + dist[1 - side][u];
+            meet = u;
+        }
+        for (int e = upOffsets[u]; e < upOffsets[u + 1]; ++e) {
+            int v = upArcs[e].to;
+            int candidate = d + upArcs[e].weight;
+            if (seen[side][v] != stamp || candidate < dist[side][v]) {
+                seen[side][v] = stamp;
+                dist[side][v] = candidate;
+                parentArc[side][v] = e;
+                queue[side].push({candidate, v});
+            }
+        }
+    }
+    return best;
+}
+
+// Returns the shortest distance between two vertices, or INT_MAX
+int ContractionHierarchy::distance(int source, int destination) {
+    int meet;
+    return search(source, destination, meet);
+}
+
+// Returns the upward arc joining two adjacent vertices of the hierarchy
+const ContractionHierarchy::Arc& ContractionHierarchy::arcBetween(int from, int to) const {
+    // The arc is stored at whichever endpoint was contracted first
+    for (int e = upOffsets[from]; e < upOffsets[from + 1]; ++e) {
+        if (upArcs[e].to == to) {
+            return upArcs[e];
+        }
+    }
+    for (int e = upOffsets[to]; e < upOffsets[to + 1]; ++e) {
+        if (upArcs[e].to == from) {
+            return upArcs[e];
+        }
+    }
+    return upArcs[upOffsets[from]];
+}
+
+// Appends the original vertices of an arc leaving from, excluding from itself
+void ContractionHierarchy::unpack(int from, const Arc& arc, std::vector<int>& route) const {
+    if (arc.middle < 0) {
+        route.push_back(arc.to);
+        return;
+    }
+    // A shortcut from-to via middle: both halves hang below middle's neighbors
+    Arc first = arcBetween(from, arc.middle);
+    first.to = arc.middle;
+    unpack(from, first, route);
+    Arc second = arcBetween(arc.middle, arc.to);
+    second.to = arc.to;
+    unpack(arc.middle, second, route);
+}
+
+// Returns the vertices of a shortest path from source to destination, or an
+// empty vector when destination is unreachable
+std::vector<int> ContractionHierarchy::path(int source, int destination) {
+    int meet;
+    std::vector<int> route;
+    if (search(source, destination, meet) == INT_MAX) {
+        return route;
+    }
+
+    // Upward arcs from source to meet, collected backwards from meet
+    std::vector<std::pair<int, int>> forward;
+    for (int v = meet; parentArc[0][v] >= 0;) {
+        int e = parentArc[0][v];
+        int from = static_cast<int>(std::upper_bound(upOffsets.begin(), upOffsets.end(), e) - upOffsets.begin()) - 1;
+        forward.push_back({from, e});
+        v = from;
+    }
+    route.push_back(source);
+    for (auto it = forward.rbegin(); it != forward.rend(); ++it) {
+        unpack(it->first, upArcs[it->second], route);
+    }
+
+    // Upward arcs from destination to meet, walked downward from meet
+    for (int v = meet; parentArc[1][v] >= 0;) {
+        int e = parentArc[1][v];
+        int from = static_cast<int>(std::upper_bound(upOffsets.begin(), upOffsets.end(), e) - upOffsets.begin()) - 1;
+        Arc down = upArcs[e];
+        down.to = from;
+        unpack(v, down, route);
+        v = from;
+    }
+    return route;
+}
@@ -1,16 +1,53 @@
 #include "Graph.h"
-#include "CustomAlgorithm.h"
 #include "CustomQueue.h"
 #include "DisjointSet.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
 #include <iostream>
 
 // Constructor to initialize the graph with V vertices
-Graph::Graph(int V) : vertices(V), adjList(V) {}
+Graph::Graph(int V) : vertices(V), edgeCount(0), adjList(V) {}
 
 // Adds an edge to the graph during the building process
 void Graph::addEdge(int v, int w, int weight) {
     adjList[v].emplace_back(w, weight);
     adjList[w].emplace_back(v, weight);
+    ++edgeCount;
+    invalidate();
+}
+
+// Returns the CSR snapshot, rebuilding it if an edge changed since the last call
+const Graph::Snapshot& Graph::snapshot() {
+    if (!csr.valid) {
+        csr.offsets.assign(vertices + 1, 0);
+        for (int v = 0; v < vertices; ++v) {
+            csr.offsets[v + 1] = csr.offsets[v] + static_cast<int>(adjList[v].size());
+        }
+        csr.neighbors.resize(csr.offsets[vertices]);
+        csr.weights.resize(csr.offsets[vertices]);
+        csr.maxWeight = 0;
+        for (int v = 0; v < vertices; ++v) {
+            int next = csr.offsets[v];
+            for (const auto& neighbor : adjList[v]) {
+                csr.neighbors[next] = neighbor.first;
+                csr.weights[next] = neighbor.second;
+                csr.maxWeight = std::max(csr.maxWeight, neighbor.second);
+                ++next;
+            }
+        }
+        csr.valid = true;
+    }
+    return csr;
+}
+
+// Drops the CSR snapshot and the contraction hierarchy after an edge change
+void Graph::invalidate() {
+    csr.valid = false;
+    if (hierarchy.isBuilt()) {
+        hierarchy.clear();
+    }
 }
 
 /*void printVectorOfLists(const std::vector<std::list<std::pair<int, int>>>& vec) {
@@ -33,32 +70,44 @@ void Graph::buildGraph(int edges[][3], int size) {
 
 // Returns the size of the graph
 std::pair<int, int> Graph::getSize() const {
-    int numVertices = vertices;
-    int numEdges = 0;
-    for (int v = 0; v < vertices; ++v) {
-        numEdges += adjList[v].size();
-    }
-    return {numVertices, numEdges / 2};
+    return {vertices, edgeCount};
 }
 
-// Dijkstra's algorithm
-std::vector<int> Graph::dijkstraShortestPath(int source) {
+// Dijkstra's algorithm. A vertex is settled the first time it leaves the
+// queue; later, stale entries for it are skipped. With a destination the
+// search stops once that vertex is settled, and only its distance is final.
+// parents, if given, receives each reached vertex's predecessor (-1 for none).
+std::vector<int> Graph::dijkstraShortestPath(int source, int destination, std::vector<int>* parents) {
+    const Snapshot& graph = snapshot();
     std::vector<int> dist(vertices, INT_MAX);
+    if (parents) {
+        parents->assign(vertices, -1);
+    }
     CustomQueue<std::pair<int, int>> pq;
 
     dist[source] = 0;
     pq.push({0, source});
 
     while (!pq.isEmpty()) {
+        int d = pq.front().first;
         int u = pq.front().second;
         pq.pop();
+        if (d > dist[u]) {
+            continue;
+        }
+        if (u == destination) {
+            break;
+        }
 
-        for (const auto& neighbor : adjList[u]) {
-            int v = neighbor.first;
-            int weight = neighbor.second;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.neighbors[e];
+            int weight = graph.weights[e];
 
             if (dist[v] > dist[u] + weight) {
                 dist[v] = dist[u] + weight;
+                if (parents) {
+                    (*parents)[v] = u;
+                }
                 pq.push({dist[v], v});
             }
         }
@@ -67,72 +116,445 @@ std::vector<int> Graph::dijkstraShortestPath(int source) {
     return dist;
 }
 
-// Computes the shortest path from source to destination using Dijkstra's algorithm
+// Builds a contraction hierarchy that answers later shortest-path queries
+// until the next edge change
+void Graph::buildHierarchy() {
+    const Snapshot& graph = snapshot();
+    hierarchy.build(vertices, graph.offsets.data(), graph.neighbors.data(), graph.weights.data());
+}
+
+// Checks if a contraction hierarchy is ready for queries
+bool Graph::hasHierarchy() const {
+    return hierarchy.isBuilt();
+}
+
+// Computes the shortest path cost from source to destination, with the
+// contraction hierarchy when one is built and Dijkstra's algorithm otherwise
 int Graph::computeShortestPath(int source, int destination){
-    std::vector<int> dist = dijkstraShortestPath(source);
+    if (hierarchy.isBuilt()) {
+        return hierarchy.distance(source, destination);
+    }
+    std::vector<int> dist = dijkstraShortestPath(source, destination);
     return dist[destination];
 }
 
-// Compares edges by weight
-bool compareEdges(const std::pair<int, std::pair<int, int>>& edge1, const std::pair<int, std::pair<int, int>>& edge2) {
-    return edge1.first > edge2.first;
+// Runs Dijkstra's algorithm from source until the destinations of the given
+// queries (indices into queries) are settled, and stores their costs in results
+void Graph::searchFrom(const Snapshot& graph, Workspace& space, int source, const std::pair<int, int>* queries,
+                       const int* indices, int count, int* results) const {
+    if (space.dist.size() != static_cast<size_t>(vertices)) {
+        space.dist.assign(vertices, 0);
+        space.seen.assign(vertices, 0);
+        space.target.assign(vertices, 0);
+        space.stamp = 0;
+    }
+    if (++space.stamp == 0) {
+        std::fill(space.seen.begin(), space.seen.end(), 0);
+        std::fill(space.target.begin(), space.target.end(), 0);
+        space.stamp = 1;
+    }
+    unsigned stamp = space.stamp;
+
+    int pending = 0;
+    for (int i = 0; i < count; ++i) {
+        int destination = queries[indices[i]].second;
+        if (destination >= 0 && destination < vertices && space.target[destination] != stamp) {
+            space.target[destination] = stamp;
+            ++pending;
+        }
+    }
+
+    CustomQueue<std::pair<int, int>> pq;
+    space.dist[source] = 0;
+    space.seen[source] = stamp;
+    pq.push({0, source});
+    while (!pq.isEmpty() && pending > 0) {
+        int d = pq.front().first;
+        int u = pq.front().second;
+        pq.pop();
+        if (d > space.dist[u]) {
+            continue;
+        }
+        if (space.target[u] == stamp) {
+            --pending;
+        }
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.neighbors[e];
+            int candidate = d + graph.weights[e];
+            if (space.seen[v] != stamp || candidate < space.dist[v]) {
+                space.seen[v] = stamp;
+                space.dist[v] = candidate;
+                pq.push({candidate, v});
+            }
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int destination = queries[indices[i]].second;
+        if (destination >= 0 && destination < vertices && space.seen[destination] == stamp) {
+            results[indices[i]] = space.dist[destination];
+        }
+    }
+}
+
+// Computes the shortest path cost of every (source, destination) pair, in
+// order; INT_MAX marks an unreachable or invalid pair. Queries that share a
+// source share one Dijkstra run, and the runs are spread over a thread pool.
+// With a contraction hierarchy built, each pair is one hierarchy query.
+std::vector<int> Graph::computeShortestPaths(const std::vector<std::pair<int, int>>& queries) {
+    std::vector<int> results(queries.size(), INT_MAX);
+    if (hierarchy.isBuilt()) {
+        for (size_t i = 0; i < queries.size(); ++i) {
+            int source = queries[i].first;
+            int destination = queries[i].second;
+            if (source >= 0 && source < vertices && destination >= 0 && destination < vertices) {
+                results[i] = hierarchy.distance(source, destination);
+            }
+        }
+        return results;
+    }
+
+    // Group the queries with a valid source by source
+    std::vector<int> order;
+    order.reserve(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (queries[i].first >= 0 && queries[i].first < vertices) {
+            order.push_back(static_cast<int>(i));
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return queries[a].first < queries[b].first; });
+    std::vector<int> groupStarts;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first) {
+            groupStarts.push_back(static_cast<int>(i));
+        }
+    }
+    int groups = static_cast<int>(groupStarts.size());
+    groupStarts.push_back(static_cast<int>(order.size()));
+    if (groups == 0) {
+        return results;
+    }
+
+    // The snapshot is built here so the workers only read it
+    const Snapshot& graph = snapshot();
+    workspaces.resize(threads().size());
+    pool->run(groups, [&](int group, int worker) {
+        int start = groupStarts[group];
+        searchFrom(graph, workspaces[worker], queries[order[start]].first, queries.data(), &order[start],
+                   groupStarts[group + 1] - start, results.data());
+    });
+    return results;
 }
 
-// Kruskal's algorithm
-int Graph::kruskalMST() {
-    std::vector<std::pair<int, std::pair<int, int>>> edges;
+// Returns the thread pool, starting it on first use
+ThreadPool& Graph::threads() {
+    if (!pool) {
+        pool.reset(new ThreadPool());
+    }
+    return *pool;
+}
+
+// Parallel delta-stepping. Tentative distances are grouped into buckets of
+// width delta, and the lowest non-empty bucket is settled as a whole: its
+// vertices relax their light edges (weight <= delta) in parallel, which may
+// refill the bucket, until it stays empty; then their heavy edges, which can
+// only reach later buckets, are relaxed once. Distances are lowered with
+// relaxed atomic compare-and-swap, and every worker files the vertices it
+// improved into its own buckets, so the only synchronization is the end of
+// each parallel step. delta defaults to the heaviest weight over the average
+// degree, which keeps buckets wide enough to be worth a parallel step while
+// few vertices are relaxed before their distance is final.
+std::vector<int> Graph::deltaSteppingShortestPath(int source) {
+    const Snapshot& graph = snapshot();
+    ThreadPool& pool = threads();
+    int workers = pool.size();
+    std::vector<int> result(vertices, INT_MAX);
+    if (source < 0 || source >= vertices) {
+        return result;
+    }
+
+    long long entries = std::max<long long>(1, graph.offsets[vertices]);
+    int delta = static_cast<int>(std::max<long long>(1, static_cast<long long>(graph.maxWeight) * vertices / entries));
+    // A relaxation from bucket b lands at most maxWeight / delta + 1 buckets
+    // later, so a ring of that many buckets is never overrun
+    int ring = graph.maxWeight / delta + 2;
+
+    typedef std::vector<std::pair<int, int>> Bucket;  // (vertex, distance when filed)
+    std::vector<std::vector<Bucket>> buckets(workers, std::vector<Bucket>(ring));
+    std::vector<Bucket> settled(workers);
+    std::unique_ptr<std::atomic<int>[]> dist(new std::atomic<int>[vertices]);
     for (int v = 0; v < vertices; ++v) {
-        for (const auto& neighbor : adjList[v]) {
-            int u = neighbor.first;
-            int weight = neighbor.second;
-            edges.push_back({weight, {v, u}});
+        dist[v].store(INT_MAX, std::memory_order_relaxed);
+    }
+
+    auto relax = [&](int worker, int v, int candidate) {
+        int current = dist[v].load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (dist[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                buckets[worker][candidate / delta % ring].push_back({v, candidate});
+                return;
+            }
+        }
+    };
+    const int Chunk = 256;
+    Bucket frontier;
+    auto parallelOver = [&](const Bucket& items, const auto& visit) {
+        int chunks = static_cast<int>((items.size() + Chunk - 1) / Chunk);
+        pool.run(chunks, [&](int chunk, int worker) {
+            size_t end = std::min(items.size(), static_cast<size_t>(chunk + 1) * Chunk);
+            for (size_t i = static_cast<size_t>(chunk) * Chunk; i < end; ++i) {
+                // Skip entries superseded by a shorter distance
+                if (dist[items[i].first].load(std::memory_order_relaxed) == items[i].second) {
+                    visit(worker, items[i].first, items[i].second);
+                }
+            }
+        });
+    };
+
+    relax(0, source, 0);
+    for (long long bucket = 0, idle = 0; idle < ring; ++bucket) {
+        int slot = static_cast<int>(bucket % ring);
+        bool found = false;
+        while (true) {
+            frontier.clear();
+            for (int worker = 0; worker < workers; ++worker) {
+                frontier.insert(frontier.end(), buckets[worker][slot].begin(), buckets[worker][slot].end());
+                buckets[worker][slot].clear();
+            }
+            if (frontier.empty()) {
+                break;
+            }
+            found = true;
+            parallelOver(frontier, [&](int worker, int u, int d) {
+                settled[worker].push_back({u, d});
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    if (graph.weights[e] <= delta) {
+                        relax(worker, graph.neighbors[e], d + graph.weights[e]);
+                    }
+                }
+            });
         }
+        if (!found) {
+            ++idle;
+            continue;
+        }
+        idle = 0;
+
+        frontier.clear();
+        for (int worker = 0; worker < workers; ++worker) {
+            frontier.insert(frontier.end(), settled[worker].begin(), settled[worker].end());
+            settled[worker].clear();
+        }
+        parallelOver(frontier, [&](int worker, int u, int d) {
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                if (graph.weights[e] > delta) {
+                    relax(worker, graph.neighbors[e], d + graph.weights[e]);
+                }
+            }
+        });
     }
 
-    CustomAlgorithm<std::pair<int, std::pair<int, int>>>::sort(edges, compareEdges);
-   /* std::cout << "Sorted Edges:" << std::endl;
-    for (const auto& edge : edges) {
-        int u = edge.second.first;
-        int v = edge.second.second;
-        int weight = edge.first;
-        std::cout << u << " - " << v << " : " << weight << std::endl;
-    }*/
-    std::vector<std::pair<int, std::pair<int, int>>> spanningTreeEdges;
+    for (int v = 0; v < vertices; ++v) {
+        result[v] = dist[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
 
-    int minCost = 0;
-    DisjointSet disjointSet(vertices);
-    for (const auto& edge : edges) {
-        int u = edge.second.first;
-        int v = edge.second.second;
-        int setU = disjointSet.find(u);
-        int setV = disjointSet.find(v);
-        if (setU != setV) {
-            minCost += edge.first;
-            disjointSet.unionSet( setU, setV);
-            spanningTreeEdges.push_back({edge.first, {u,v}});
+// Computes the shortest path cost from source to every vertex (INT_MAX where
+// unreachable) with the chosen engine
+std::vector<int> Graph::computeDistances(int source, ShortestPathMethod method) {
+    if (method == ShortestPathMethod::DeltaStepping) {
+        return deltaSteppingShortestPath(source);
+    }
+    if (source < 0 || source >= vertices) {
+        return std::vector<int>(vertices, INT_MAX);
+    }
+    return dijkstraShortestPath(source);
+}
+
+// Returns the vertices of a shortest path from source to destination, or an
+// empty vector when there is none
+std::vector<int> Graph::computePath(int source, int destination) {
+    if (hierarchy.isBuilt()) {
+        return hierarchy.path(source, destination);
+    }
+    std::vector<int> parents;
+    std::vector<int> dist = dijkstraShortestPath(source, destination, &parents);
+    std::vector<int> path;
+    if (dist[destination] == INT_MAX) {
+        return path;
+    }
+    for (int v = destination; v != -1; v = parents[v]) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
 
+// Returns every edge once, from its lower endpoint; self-loops are left out
+std::vector<Graph::Edge> Graph::undirectedEdges() {
+    const Snapshot& graph = snapshot();
+    std::vector<Edge> edges;
+    edges.reserve(graph.neighbors.size() / 2);
+    for (int v = 0; v < vertices; ++v) {
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            if (v < graph.neighbors[e]) {
+                edges.push_back({graph.weights[e], {v, graph.neighbors[e]}});
+            }
         }
     }
+    return edges;
+}
 
-  /*  std::cout << "Spanning Tree Edges:\n";
-    for (const auto& edge : spanningTreeEdges) {
-        std::cout << edge.second.first << " - " << edge.second.second << " : " << edge.first << std::endl;
-    }*/
-    return minCost;
+// Filter-Kruskal on edges[begin, end). The range is split at a pivot weight;
+// the light half is solved first, after which every heavy edge whose
+// endpoints it already joined is dropped before the heavy half is solved.
+// On sparse-enough graphs most heavy edges are filtered out this way and
+// never sorted. Small ranges are sorted and scanned directly.
+void Graph::filterKruskal(std::vector<Edge>& edges, size_t begin, size_t end, DisjointSet& forest, std::vector<Edge>& tree) {
+    const size_t SortDirectly = 1024;
+    if (begin == end || tree.size() + 1 >= static_cast<size_t>(vertices)) {
+        return;
+    }
+    if (end - begin > SortDirectly) {
+        int a = edges[begin].first;
+        int b = edges[begin + (end - begin) / 2].first;
+        int c = edges[end - 1].first;
+        int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+        size_t split = std::partition(edges.begin() + begin, edges.begin() + end,
+                                      [pivot](const Edge& edge) { return edge.first <= pivot; }) - edges.begin();
+        // A split that leaves one side empty would recurse forever; sort instead
+        if (split != end) {
+            filterKruskal(edges, begin, split, forest, tree);
+            size_t kept = std::remove_if(edges.begin() + split, edges.begin() + end, [&](const Edge& edge) {
+                return forest.find(edge.second.first) == forest.find(edge.second.second);
+            }) - edges.begin();
+            filterKruskal(edges, split, kept, forest, tree);
+            return;
+        }
+    }
+
+    std::sort(edges.begin() + begin, edges.begin() + end);
+    for (size_t i = begin; i < end; ++i) {
+        if (forest.unionSet(edges[i].second.first, edges[i].second.second)) {
+            tree.push_back(edges[i]);
+        }
+    }
+}
+
+// Kruskal's algorithm, in its filter-Kruskal form
+std::vector<Graph::Edge> Graph::kruskalMST() {
+    std::vector<Edge> edges = undirectedEdges();
+    std::vector<Edge> tree;
+    DisjointSet forest(vertices);
+    filterKruskal(edges, 0, edges.size(), forest, tree);
+    return tree;
+}
+
+// Boruvka's algorithm. Each round every component picks its cheapest edge to
+// another component, and all picked edges join the tree at once, so at least
+// half the components merge per round. The edge scan of a round runs in
+// parallel: workers record the cheapest edge per component with an atomic
+// minimum over (weight, edge index), which breaks ties the same way for
+// everyone and so never closes a cycle, and they drop edges that already
+// lie inside one component as they go.
+std::vector<Graph::Edge> Graph::boruvkaMST() {
+    std::vector<Edge> edges = undirectedEdges();
+    std::vector<Edge> tree;
+    ThreadPool& pool = threads();
+    DisjointSet forest(vertices);
+    std::vector<int> component(vertices);
+    for (int v = 0; v < vertices; ++v) {
+        component[v] = v;
+    }
+
+    const uint64_t None = ~uint64_t(0);
+    const size_t Chunk = 16384;
+    std::unique_ptr<std::atomic<uint64_t>[]> cheapest(new std::atomic<uint64_t>[vertices]);
+    std::vector<size_t> keptPerChunk;
+    while (!edges.empty()) {
+        for (int v = 0; v < vertices; ++v) {
+            cheapest[v].store(None, std::memory_order_relaxed);
+        }
+        int chunks = static_cast<int>((edges.size() + Chunk - 1) / Chunk);
+        keptPerChunk.assign(chunks, 0);
+        pool.run(chunks, [&](int chunk, int) {
+            size_t begin = chunk * Chunk;
+            size_t end = std::min(edges.size(), begin + Chunk);
+            size_t kept = begin;
+            for (size_t i = begin; i < end; ++i) {
+                int u = component[edges[i].second.first];
+                int v = component[edges[i].second.second];
+                if (u == v) {
+                    continue;
+                }
+                edges[kept] = edges[i];
+                // Flipping the sign bit makes signed weights compare correctly as unsigned
+                uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(edges[i].first) ^ 0x80000000u) << 32 | kept;
+                for (int side : {u, v}) {
+                    uint64_t current = cheapest[side].load(std::memory_order_relaxed);
+                    while (key < current) {
+                        if (cheapest[side].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    }
+                }
+                ++kept;
+            }
+            keptPerChunk[chunk] = kept - begin;
+        });
+
+        // Join the picked edges, then compact the surviving edges
+        for (int v = 0; v < vertices; ++v) {
+            uint64_t key = cheapest[v].load(std::memory_order_relaxed);
+            if (key != None) {
+                const Edge& edge = edges[key & 0xFFFFFFFFu];
+                if (forest.unionSet(edge.second.first, edge.second.second)) {
+                    tree.push_back(edge);
+                }
+            }
+        }
+        size_t size = 0;
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            std::move(edges.begin() + chunk * Chunk, edges.begin() + chunk * Chunk + keptPerChunk[chunk], edges.begin() + size);
+            size += keptPerChunk[chunk];
+        }
+        edges.resize(size);
+        for (int v = 0; v < vertices; ++v) {
+            component[v] = forest.find(v);
+        }
+    }
+    return tree;
+}
+
+// Returns the edges of a minimum spanning tree (a forest if the graph is not connected)
+std::vector<Graph::Edge> Graph::spanningTreeEdges(SpanningTreeMethod method) {
+    return method == SpanningTreeMethod::Boruvka ? boruvkaMST() : kruskalMST();
 }
 
-// Computes the minimum spanning tree using Kruskal's algorithm
-int Graph::computeSpanningTree(){
-    return kruskalMST();
+// Computes the cost of a minimum spanning tree
+int Graph::computeSpanningTree(SpanningTreeMethod method) {
+    int minCost = 0;
+    for (const Edge& edge : spanningTreeEdges(method)) {
+        minCost += edge.first;
+    }
+    return minCost;
 }
 
-// DFS algorithm
+// DFS algorithm, with an explicit stack so long paths cannot overflow the call stack
 void Graph::dfs(int v, std::vector<bool>& visited) {
+    const Snapshot& graph = snapshot();
+    std::vector<int> stack(1, v);
     visited[v] = true;
-    for (const auto& neighbor : adjList[v]) {
-        int u = neighbor.first;
-        if (!visited[u]) {
-            dfs(u, visited);
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int w = graph.neighbors[e];
+            if (!visited[w]) {
+                visited[w] = true;
+                stack.push_back(w);
+            }
         }
     }
 }
@@ -158,6 +580,12 @@ void Graph::resize(size_t newSize) {
         }
     adjList.resize(newSize);
    vertices = newSize;
+        int entries = 0;
+        for (int v = 0; v < vertices; ++v) {
+            entries += adjList[v].size();
+        }
+        edgeCount = entries / 2;
+        invalidate();
     }
 }
 
@@ -173,6 +601,8 @@ bool Graph::insertEdge(int source, int destination, int weight) {
 
     adjList[source].emplace_back(destination, weight);
     adjList[destination].emplace_back(source, weight);
+    ++edgeCount;
+    invalidate();
     return true;
 }
 
@@ -181,9 +611,11 @@ bool Graph::deleteEdge(int source, int destination) {
     if (source < 0 || source >= vertices || destination < 0 || destination >= vertices)
         return false;
 
+    bool found = false;
     for (auto it = adjList[source].begin(); it != adjList[source].end(); ++it) {
         if (it->first == destination) {
             adjList[source].erase(it);
+            found = true;
             break;
         }
     }
@@ -195,6 +627,10 @@ bool Graph::deleteEdge(int source, int destination) {
         }
     }
 
+    if (found) {
+        --edgeCount;
+        invalidate();
+    }
     return true;
 }
 
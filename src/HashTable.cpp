@@ -1,24 +1,257 @@
 #include "HashTable.h"
 #include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include <fstream>
 
-// Constructor to initialize the hash table with a given size
-HashTable::HashTable(int size) : capacity(size), table(size) {}
+// Constructor to initialize the hash table with room for size keys
+HashTable::HashTable(int size)
+    : migrateCursor(0), filterRate(0), filterBudget(0), filterRejects(0), filterPasses(0), filterFalsePositives(0),
+      dense(false) {
+    allocate(current, capacityFor(size));
+    draining = Table{0, 0, 0, nullptr, nullptr};
+}
+
+// Destructor to free both tables
+HashTable::~HashTable() {
+    release(current);
+    release(draining);
+}
+
+// Returns the smallest power-of-two capacity that holds keys at 7/8 load
+int HashTable::capacityFor(int keys) {
+    int needed = keys + keys / 7 + 1;
+    int result = GroupSize;
+    while (result < needed) {
+        result *= 2;
+    }
+    return result;
+}
+
+// Allocates empty control bytes and slots for capacity slots
+void HashTable::allocate(Table& table, int capacity) {
+    table.capacity = capacity;
+    table.count = 0;
+    table.growthLeft = capacity - capacity / 8;
+    table.control = static_cast<int8_t*>(::operator new(capacity, std::align_val_t(GroupSize)));
+    table.slots = new int[capacity];
+    for (int i = 0; i < capacity; ++i) {
+        table.control[i] = swissEmpty;
+    }
+}
+
+// Frees the control bytes and slots of a table
+void HashTable::release(Table& table) {
+    if (table.control) {
+        ::operator delete(table.control, std::align_val_t(GroupSize));
+    }
+    delete[] table.slots;
+    table = Table{0, 0, 0, nullptr, nullptr};
+}
+
+// Hash function spreading keys over the groups. The low 7 bits become the
+// control byte; the bits above pick the first group.
+uint64_t HashTable::hashFunction(int key) {
+    return swissHash(key);
+}
+
+// Returns the slot of table holding key, or -1. Groups are probed in
+// triangular order until one with an empty slot proves the key absent.
+int HashTable::findSlot(const Table& table, int key, uint64_t hash) {
+    if (table.capacity == 0) {
+        return -1;
+    }
+    int8_t tag = static_cast<int8_t>(hash & 0x7F);
+    uint64_t mask = table.capacity / GroupSize - 1;
+    uint64_t group = (hash >> 7) & mask;
+    for (uint64_t step = 1;; ++step) {
+        const int8_t* bytes = table.control + group * GroupSize;
+        for (uint32_t match = swissMatch(bytes, tag); match; match &= match - 1) {
+            int slot = static_cast<int>(group * GroupSize) + __builtin_ctz(match);
+            if (table.slots[slot] == key) {
+                return slot;
+            }
+        }
+        if (swissMatch(bytes, swissEmpty)) {
+            return -1;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+// Starts loading the first group a lookup of hash will probe
+void HashTable::prefetchGroup(const Table& table, uint64_t hash) {
+    if (table.capacity != 0) {
+        uint64_t group = (hash >> 7) & (table.capacity / GroupSize - 1);
+        __builtin_prefetch(table.control + group * GroupSize);
+        __builtin_prefetch(table.slots + group * GroupSize);
+    }
+}
+
+// Stores a key known to be absent in the first free slot of its probe sequence
+void HashTable::insertNew(Table& table, int key, uint64_t hash) {
+    uint64_t mask = table.capacity / GroupSize - 1;
+    uint64_t group = (hash >> 7) & mask;
+    for (uint64_t step = 1;; ++step) {
+        uint32_t free = swissMatchFree(table.control + group * GroupSize);
+        if (free) {
+            int slot = static_cast<int>(group * GroupSize) + __builtin_ctz(free);
+            if (table.control[slot] == swissEmpty) {
+                --table.growthLeft;
+            }
+            table.control[slot] = static_cast<int8_t>(hash & 0x7F);
+            table.slots[slot] = key;
+            ++table.count;
+            return;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+// Frees a full slot. A group that still has an empty slot never made a probe
+// move past it, so the slot can become empty again instead of a tombstone.
+void HashTable::eraseSlot(Table& table, int slot) {
+    const int8_t* group = table.control + (slot / GroupSize) * GroupSize;
+    if (swissMatch(group, swissEmpty)) {
+        table.control[slot] = swissEmpty;
+        ++table.growthLeft;
+    } else {
+        table.control[slot] = swissDeleted;
+    }
+    --table.count;
+}
 
-// Hash function to map keys to table indices
-int HashTable::hashFunction(int key) {
-    return key % capacity;
+// Starts moving keys into a fresh table of newCapacity slots
+void HashTable::startRehash(int newCapacity) {
+    finishRehash();
+    draining = current;
+    migrateCursor = 0;
+    allocate(current, newCapacity);
+    if (filterRate > 0) {
+        resetFilter(nextFilter, newCapacity);
+    }
 }
 
-// Inserts a key into the hash table
+// Moves the keys of the next few groups of the draining table. Moved slots
+// become tombstones so the keys still waiting behind them stay reachable.
+void HashTable::migrate(int groups) {
+    if (draining.capacity == 0) {
+        return;
+    }
+    int end = migrateCursor + groups * GroupSize;
+    if (end > draining.capacity) {
+        end = draining.capacity;
+    }
+    for (; migrateCursor < end; ++migrateCursor) {
+        if (draining.control[migrateCursor] >= 0) {
+            int key = draining.slots[migrateCursor];
+            uint64_t hash = hashFunction(key);
+            insertNew(current, key, hash);
+            if (filterRate > 0) {
+                nextFilter.add(hash);
+            }
+            draining.control[migrateCursor] = swissDeleted;
+            --draining.count;
+        }
+    }
+    if (migrateCursor == draining.capacity) {
+        release(draining);
+        if (filterRate > 0) {
+            std::swap(filter, nextFilter);
+            nextFilter.clear();
+        }
+    }
+}
+
+// Moves every remaining key out of the draining table
+void HashTable::finishRehash() {
+    migrate(draining.capacity / GroupSize);
+}
+
+// Inserts a key into the hash table; keys already present are ignored
 void HashTable::insert(int key) {
-    int index = hashFunction(key);
-    table[index].push_back(key);
+    thaw();
+    if (dense) {
+        denseKeys.add(key);
+        return;
+    }
+    migrate(MigrateGroups);
+    uint64_t hash = hashFunction(key);
+    if (findSlot(current, key, hash) >= 0 || findSlot(draining, key, hash) >= 0) {
+        return;
+    }
+    if (current.growthLeft == 0) {
+        // Mostly tombstones: clean up at the same size, otherwise double
+        int keys = current.count + draining.count;
+        int limit = current.capacity - current.capacity / 8;
+        startRehash(keys * 2 < limit ? current.capacity : current.capacity * 2);
+    }
+    insertNew(current, key, hash);
+    if (filterRate > 0) {
+        filter.add(hash);
+        if (draining.capacity != 0) {
+            nextFilter.add(hash);
+        }
+    }
 }
 
-// Builds the hash table from an array of elements
+// Removes a key from the hash table; returns false if it was not present
+bool HashTable::erase(int key) {
+    thaw();
+    if (dense) {
+        return denseKeys.remove(key);
+    }
+    migrate(MigrateGroups);
+    uint64_t hash = hashFunction(key);
+    int slot = findSlot(current, key, hash);
+    if (slot >= 0) {
+        eraseSlot(current, slot);
+        return true;
+    }
+    slot = findSlot(draining, key, hash);
+    if (slot >= 0) {
+        eraseSlot(draining, slot);
+        return true;
+    }
+    return false;
+}
+
+// Checks if at least one in DenseSpanPerKey values between the smallest and
+// largest element is present (duplicates aside)
+bool HashTable::isDenseRange(const int* elements, int size) {
+    if (size < DenseMinKeys) {
+        return false;
+    }
+    int lo = elements[0];
+    int hi = elements[0];
+    for (int i = 1; i < size; ++i) {
+        lo = elements[i] < lo ? elements[i] : lo;
+        hi = elements[i] > hi ? elements[i] : hi;
+    }
+    return static_cast<int64_t>(hi) - lo + 1 <= static_cast<int64_t>(size) * DenseSpanPerKey;
+}
+
+// Builds the hash table from an array of elements, growing once up front.
+// An empty table given a dense range switches to the compressed set.
 void HashTable::buildTable(int* elements, int size) {
+    thaw();
+    if (getSize() == 0 && !dense && isDenseRange(elements, size)) {
+        dense = true;
+    }
+    if (dense) {
+        for (int i = 0; i < size; ++i) {
+            denseKeys.add(elements[i]);
+        }
+        denseKeys.optimize();
+        return;
+    }
+    int needed = capacityFor(getSize() + size);
+    if (needed > current.capacity) {
+        startRehash(needed);
+        finishRehash();
+    }
     for (int i = 0; i < size; ++i) {
         insert(elements[i]);
     }
@@ -26,34 +259,248 @@ void HashTable::buildTable(int* elements, int size) {
 
 // Returns the size of the hash table
 int HashTable::getSize() const {
-    int size = 0;
-    for (int i = 0; i < capacity; ++i) {
-        size += table[i].size();
+    return current.count + draining.count + static_cast<int>(denseKeys.getSize() + frozen.size());
+}
+
+// Returns the number of slots in the current table
+int HashTable::getCapacity() const {
+    return current.capacity;
+}
+
+// Checks the filter, then both tables, counting how the filter did
+bool HashTable::lookup(int key, uint64_t hash) const {
+    if (frozen.isBuilt()) {
+        return frozen.contains(key);
+    }
+    if (dense) {
+        return denseKeys.contains(key);
+    }
+    if (filterRate > 0) {
+        if (!filter.mayContain(hash)) {
+            ++filterRejects;
+            return false;
+        }
+        ++filterPasses;
     }
-    return size;
+    if (findSlot(current, key, hash) >= 0 || findSlot(draining, key, hash) >= 0) {
+        return true;
+    }
+    if (filterRate > 0) {
+        ++filterFalsePositives;
+    }
+    return false;
+}
+
+// Checks if a key is in the hash table (without advancing a pending rehash)
+bool HashTable::contains(int key) const {
+    return lookup(key, hashFunction(key));
 }
 
 // Searches for a key in the hash table
 std::string HashTable::search(int key) {
-    int index = hashFunction(key);
-    for (const auto& element : table[index]) {
-        if (element == key) {
-            return "SUCCESS";
+    migrate(MigrateGroups);
+    return contains(key) ? "SUCCESS" : "FAILURE";
+}
+
+// Looks up n keys and sets bit i of the bitmap found (n / 8 rounded up bytes,
+// least significant bit first) when keys[i] is present. Keys are handled
+// BatchWidth at a time: all of them are hashed and their filter blocks and
+// first groups prefetched before any is probed, so the cache misses overlap.
+void HashTable::searchBatch(const int* keys, std::size_t n, uint8_t* found) {
+    migrate(MigrateGroups);
+    uint64_t hashes[BatchWidth];
+    bool filtered = filterRate > 0 && !dense && !frozen.isBuilt();
+    for (std::size_t i = 0; i < (n + 7) / 8; ++i) {
+        found[i] = 0;
+    }
+    for (std::size_t begin = 0; begin < n; begin += BatchWidth) {
+        std::size_t width = n - begin < BatchWidth ? n - begin : BatchWidth;
+        for (std::size_t i = 0; i < width; ++i) {
+            hashes[i] = hashFunction(keys[begin + i]);
+            if (filtered) {
+                filter.prefetch(hashes[i]);
+            } else {
+                prefetchGroup(current, hashes[i]);
+                prefetchGroup(draining, hashes[i]);
+            }
+        }
+        if (filtered) {
+            for (std::size_t i = 0; i < width; ++i) {
+                if (filter.mayContain(hashes[i])) {
+                    prefetchGroup(current, hashes[i]);
+                    prefetchGroup(draining, hashes[i]);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < width; ++i) {
+            if (lookup(keys[begin + i], hashes[i])) {
+                found[(begin + i) / 8] |= static_cast<uint8_t>(1u << ((begin + i) % 8));
+            }
         }
     }
-    return "FAILURE";
+}
+
+// Checks if the keys are held in the compressed dense-range set
+bool HashTable::isDense() const {
+    return dense;
+}
+
+// Adds every key of other to this table. Two dense tables merge their
+// bitmaps container by container.
+void HashTable::unionWith(const HashTable& other) {
+    thaw();
+    if (dense && other.dense) {
+        denseKeys.unionWith(other.denseKeys);
+        return;
+    }
+    other.forEachKey([this](int key) { insert(key); });
+}
+
+// Keeps only the keys that other also holds
+void HashTable::intersectWith(const HashTable& other) {
+    thaw();
+    if (dense && other.dense) {
+        denseKeys.intersectWith(other.denseKeys);
+        return;
+    }
+    std::vector<int> dropped;
+    forEachKey([&other, &dropped](int key) {
+        if (!other.contains(key)) {
+            dropped.push_back(key);
+        }
+    });
+    for (int key : dropped) {
+        erase(key);
+    }
+}
+
+// Moves every key into a minimal-perfect-hash index and frees the table
+void HashTable::freeze() {
+    if (frozen.isBuilt()) {
+        return;
+    }
+    std::vector<int> keys;
+    keys.reserve(getSize());
+    forEachKey([&keys](int key) { keys.push_back(key); });
+    clearKeys();
+    frozen.build(keys.data(), keys.size());
+}
+
+// Drops every key, leaving an empty table of one group
+void HashTable::clearKeys() {
+    release(current);
+    release(draining);
+    allocate(current, GroupSize);
+    denseKeys.clear();
+    dense = false;
+    frozen.clear();
+    filter.clear();
+    nextFilter.clear();
+}
+
+// Checks if lookups are served by the frozen perfect-hash index
+bool HashTable::isFrozen() const {
+    return frozen.isBuilt();
+}
+
+// Rebuilds the mutable table from the frozen index before a change
+void HashTable::thaw() {
+    if (!frozen.isBuilt()) {
+        return;
+    }
+    std::vector<int> keys(frozen.data(), frozen.data() + frozen.size());
+    frozen.clear();
+    if (filterRate > 0) {
+        resetFilter(filter, current.capacity);
+    }
+    buildTable(keys.data(), static_cast<int>(keys.size()));
+}
+
+// Freezes the table and writes the index to a file; returns false on failure
+bool HashTable::save(const std::string& filename) {
+    freeze();
+    std::ofstream file(filename, std::ios::binary);
+    return file.is_open() && frozen.save(file);
+}
+
+// Replaces the contents with a frozen index read from a file written by
+// save; returns false (leaving the table unchanged) on failure
+bool HashTable::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    PerfectHashIndex loaded;
+    if (!file.is_open() || !loaded.load(file)) {
+        return false;
+    }
+    clearKeys();
+    std::swap(frozen, loaded);
+    return true;
+}
+
+// Sizes a filter for the keys a table of capacity slots holds at full load
+void HashTable::resetFilter(BloomFilter& target, int capacity) const {
+    target.reset(capacity - capacity / 8, filterRate, filterBudget);
+}
+
+// Puts a Bloom filter with the given false-positive rate in front of the
+// table, using at most maxBytes (0 for no limit), and fills it with the keys
+void HashTable::enableFilter(double falsePositiveRate, std::size_t maxBytes) {
+    thaw();
+    finishRehash();
+    filterRate = falsePositiveRate > 0 && falsePositiveRate < 1 ? falsePositiveRate : 0.01;
+    filterBudget = maxBytes;
+    resetFilter(filter, current.capacity);
+    for (int i = 0; i < current.capacity; ++i) {
+        if (current.control[i] >= 0) {
+            filter.add(hashFunction(current.slots[i]));
+        }
+    }
+    filterRejects = filterPasses = filterFalsePositives = 0;
+}
+
+// Removes the filter and frees its memory
+void HashTable::disableFilter() {
+    filterRate = 0;
+    filter.clear();
+    nextFilter.clear();
+}
+
+// Returns the memory held by the filter
+std::size_t HashTable::getFilterBytes() const {
+    return filter.bytes() + nextFilter.bytes();
+}
+
+// Returns how many lookups the filter answered alone (keys proven absent)
+uint64_t HashTable::getFilterRejects() const {
+    return filterRejects;
+}
+
+// Returns how many lookups the filter passed on to the table
+uint64_t HashTable::getFilterPasses() const {
+    return filterPasses;
+}
+
+// Returns how many passed lookups then missed in the table
+uint64_t HashTable::getFilterFalsePositives() const {
+    return filterFalsePositives;
 }
 
 // Prints the hash table to a file
 void HashTable::printTable(std::ofstream& output) {
-    for (int i = 0; i < capacity; ++i) {
-        if (!table[i].empty()) {
-            output << "Index " << i << ":";
-            for (const auto& element : table[i]) {
-                output << " " << element;
-            }
-            output << std::endl;
+    if (frozen.isBuilt()) {
+        for (std::size_t i = 0; i < frozen.size(); ++i) {
+            output << "Index " << i << ": " << frozen.data()[i] << std::endl;
+        }
+        return;
+    }
+    if (dense) {
+        int index = 0;
+        denseKeys.forEach([&output, &index](int key) { output << "Index " << index++ << ": " << key << std::endl; });
+        return;
+    }
+    finishRehash();
+    for (int i = 0; i < current.capacity; ++i) {
+        if (current.control[i] >= 0) {
+            output << "Index " << i << ": " << current.slots[i] << std::endl;
         }
     }
 }
-
@@ -0,0 +1,223 @@
+#include "PerfectHashIndex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char FileMagic[4] = {'M', 'P', 'H', 'F'};
+const uint32_t FileVersion = 1;
+
+// Bits per key on each level; BBHash's gamma
+const double LevelGamma = 2.0;
+
+template <typename T>
+void writeVector(std::ostream& output, const std::vector<T>& values) {
+    uint64_t count = values.size();
+    output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+bool readVector(std::istream& input, std::vector<T>& values) {
+    uint64_t count = 0;
+    if (!input.read(reinterpret_cast<char*>(&count), sizeof(count)) || count > (uint64_t(1) << 40) / sizeof(T)) {
+        return false;
+    }
+    // Grow in chunks as data arrives, so a corrupt count cannot allocate
+    // far more than the stream holds
+    const uint64_t Chunk = 1 << 16;
+    values.clear();
+    for (uint64_t done = 0; done < count;) {
+        uint64_t step = std::min(Chunk, count - done);
+        values.resize(done + step);
+        if (!input.read(reinterpret_cast<char*>(values.data() + done), static_cast<std::streamsize>(step * sizeof(T)))) {
+            return false;
+        }
+        done += step;
+    }
+    return true;
+}
+
+} // namespace
+
+// Constructor to create an empty, unbuilt index
+PerfectHashIndex::PerfectHashIndex() : built(false) {}
+
+// Hashes a key independently for each level (MurmurHash3 finalizer over a
+// per-level offset)
+uint64_t PerfectHashIndex::levelHash(int key, int level) {
+    uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(key)) + (static_cast<uint64_t>(level) + 1) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Builds the function over count distinct keys. On each level every
+// remaining key picks a bit; keys that picked a bit alone keep it and the
+// others move to the next, smaller level.
+void PerfectHashIndex::build(const int* keys, std::size_t count) {
+    clear();
+    std::vector<int> remaining(keys, keys + count);
+    std::vector<int> next;
+    std::vector<uint64_t> collisions;
+    levelOffsets.push_back(0);
+
+    for (int level = 0; level < MaxLevels && !remaining.empty(); ++level) {
+        uint64_t levelBits = static_cast<uint64_t>(LevelGamma * remaining.size()) + 64;
+        levelBits = (levelBits + 63) / 64 * 64;
+        uint64_t offset = levelOffsets.back();
+        bits.resize((offset + levelBits) / 64, 0);
+        collisions.assign(levelBits / 64, 0);
+
+        for (int key : remaining) {
+            uint64_t bit = ((levelHash(key, level) >> 32) * levelBits) >> 32;
+            uint64_t& word = bits[(offset + bit) / 64];
+            uint64_t mask = uint64_t(1) << (bit % 64);
+            if (word & mask) {
+                collisions[bit / 64] |= mask;
+            }
+            word |= mask;
+        }
+        next.clear();
+        for (int key : remaining) {
+            uint64_t bit = ((levelHash(key, level) >> 32) * levelBits) >> 32;
+            if (collisions[bit / 64] & (uint64_t(1) << (bit % 64))) {
+                next.push_back(key);
+            }
+        }
+        for (uint64_t i = 0; i < levelBits / 64; ++i) {
+            bits[offset / 64 + i] &= ~collisions[i];
+        }
+        levelOffsets.push_back(offset + levelBits);
+        remaining.swap(next);
+    }
+    std::sort(remaining.begin(), remaining.end());
+    fallback = remaining;
+
+    blockRanks.assign((bits.size() + WordsPerBlock - 1) / WordsPerBlock, 0);
+    uint32_t ones = 0;
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (i % WordsPerBlock == 0) {
+            blockRanks[i / WordsPerBlock] = ones;
+        }
+        ones += __builtin_popcountll(bits[i]);
+    }
+
+    this->keys.assign(count, 0);
+    built = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        this->keys[lookup(keys[i])] = keys[i];
+    }
+}
+
+// Frees the index
+void PerfectHashIndex::clear() {
+    std::vector<uint64_t>().swap(levelOffsets);
+    std::vector<uint64_t>().swap(bits);
+    std::vector<uint32_t>().swap(blockRanks);
+    std::vector<int>().swap(fallback);
+    std::vector<int>().swap(keys);
+    built = false;
+}
+
+// Returns the number of set bits before a position
+uint64_t PerfectHashIndex::rank(uint64_t position) const {
+    uint64_t word = position / 64;
+    uint64_t result = blockRanks[word / WordsPerBlock];
+    for (uint64_t i = word / WordsPerBlock * WordsPerBlock; i < word; ++i) {
+        result += __builtin_popcountll(bits[i]);
+    }
+    return result + __builtin_popcountll(bits[word] & ((uint64_t(1) << (position % 64)) - 1));
+}
+
+// Evaluates the function; absent keys get an arbitrary index or -1
+long PerfectHashIndex::lookup(int key) const {
+    int levels = static_cast<int>(levelOffsets.size()) - 1;
+    for (int level = 0; level < levels; ++level) {
+        uint64_t levelBits = levelOffsets[level + 1] - levelOffsets[level];
+        uint64_t position = levelOffsets[level] + (((levelHash(key, level) >> 32) * levelBits) >> 32);
+        if (bits[position / 64] & (uint64_t(1) << (position % 64))) {
+            return static_cast<long>(rank(position));
+        }
+    }
+    auto found = std::lower_bound(fallback.begin(), fallback.end(), key);
+    if (found == fallback.end() || *found != key) {
+        return -1;
+    }
+    return static_cast<long>(keys.size() - fallback.size() + (found - fallback.begin()));
+}
+
+// Returns the index of a key in [0, size()), or -1 if it is not in the set
+long PerfectHashIndex::indexOf(int key) const {
+    if (!built) {
+        return -1;
+    }
+    long index = lookup(key);
+    return index >= 0 && keys[index] == key ? index : -1;
+}
+
+// Checks if key is in the index
+bool PerfectHashIndex::contains(int key) const {
+    return indexOf(key) >= 0;
+}
+
+// Returns the bytes held by the function and the keys
+std::size_t PerfectHashIndex::bytes() const {
+    return levelOffsets.size() * sizeof(uint64_t) + bits.size() * sizeof(uint64_t) +
+           blockRanks.size() * sizeof(uint32_t) + (fallback.size() + keys.size()) * sizeof(int);
+}
+
+// Writes the index in native byte order; returns false on a stream error
+bool PerfectHashIndex::save(std::ostream& output) const {
+    output.write(FileMagic, sizeof(FileMagic));
+    output.write(reinterpret_cast<const char*>(&FileVersion), sizeof(FileVersion));
+    writeVector(output, levelOffsets);
+    writeVector(output, bits);
+    writeVector(output, blockRanks);
+    writeVector(output, fallback);
+    writeVector(output, keys);
+    return static_cast<bool>(output);
+}
+
+// Reads an index written by save; on failure the index is left empty
+bool PerfectHashIndex::load(std::istream& input) {
+    clear();
+    char magic[sizeof(FileMagic)];
+    uint32_t version = 0;
+    bool ok = input.read(magic, sizeof(magic)) && std::memcmp(magic, FileMagic, sizeof(magic)) == 0 &&
+              input.read(reinterpret_cast<char*>(&version), sizeof(version)) && version == FileVersion &&
+              readVector(input, levelOffsets) && readVector(input, bits) && readVector(input, blockRanks) &&
+              readVector(input, fallback) && readVector(input, keys) && !levelOffsets.empty() &&
+              levelOffsets.back() == bits.size() * 64 && blockRanks.size() == (bits.size() + WordsPerBlock - 1) / WordsPerBlock;
+    if (!ok || !consistent()) {
+        clear();
+        return false;
+    }
+    built = true;
+    return true;
+}
+
+// Checks that loaded vectors fit together, so no lookup can index past an
+// array: levels are non-empty and in order, the ranks match the bits, every
+// set bit and fallback key has a slot in keys, and the fallback is sorted
+bool PerfectHashIndex::consistent() const {
+    if (levelOffsets.front() != 0 || levelOffsets.size() > MaxLevels + 1) {
+        return false;
+    }
+    for (std::size_t level = 1; level < levelOffsets.size(); ++level) {
+        if (levelOffsets[level] <= levelOffsets[level - 1]) {
+            return false;
+        }
+    }
+    uint64_t ones = 0;
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (i % WordsPerBlock == 0 && blockRanks[i / WordsPerBlock] != ones) {
+            return false;
+        }
+        ones += __builtin_popcountll(bits[i]);
+    }
+    return ones + fallback.size() == keys.size() && std::is_sorted(fallback.begin(), fallback.end());
+}
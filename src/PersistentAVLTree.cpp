@@ -0,0 +1,346 @@
+#include "PersistentAVLTree.h"
+#include <algorithm>
+#include <thread>
+
+// Constructor to initialize an empty tree at epoch 1
+PersistentAVLTree::PersistentAVLTree() : root(AVL_NIL), globalEpoch(1) {}
+
+// Claims a reader slot, announces the current epoch and pins the current root
+PersistentAVLTree::Snapshot::Snapshot(const PersistentAVLTree* tree) : tree(tree), slot(-1), root(AVL_NIL) {
+    while (slot < 0) {
+        for (int i = 0; i < MaxReaders; ++i) {
+            bool expected = false;
+            if (tree->readers[i].inUse.compare_exchange_strong(expected, true)) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) {
+            std::this_thread::yield();
+        }
+    }
+    tree->readers[slot].epoch.store(tree->globalEpoch.load());
+    root = tree->root.load();
+}
+
+// Move constructor transferring the pinned version
+PersistentAVLTree::Snapshot::Snapshot(Snapshot&& other) noexcept : tree(other.tree), slot(other.slot), root(other.root) {
+    other.slot = -1;
+}
+
+// Releases the reader slot so the writer may reclaim this version
+PersistentAVLTree::Snapshot::~Snapshot() {
+    if (slot >= 0) {
+        tree->readers[slot].epoch.store(0);
+        tree->readers[slot].inUse.store(false);
+    }
+}
+
+// Checks if a key is in the pinned version
+bool PersistentAVLTree::Snapshot::contains(int key) const {
+    AVLIndex node = root;
+    while (node != AVL_NIL && tree->nodes[node].key != key) {
+        node = key < tree->nodes[node].key ? tree->nodes[node].left : tree->nodes[node].right;
+    }
+    return node != AVL_NIL;
+}
+
+// Returns the number of keys in the pinned version
+int PersistentAVLTree::Snapshot::getSize() const {
+    return tree->size(root);
+}
+
+// Finds the minimum key in the pinned version
+int PersistentAVLTree::Snapshot::findMin() const {
+    AVLIndex node = root;
+    if (node == AVL_NIL) {
+        return -1;
+    }
+    while (tree->nodes[node].left != AVL_NIL) {
+        node = tree->nodes[node].left;
+    }
+    return tree->nodes[node].key;
+}
+
+// Returns the height of a node
+int PersistentAVLTree::height(AVLIndex node) const {
+    return node != AVL_NIL ? nodes[node].height : 0;
+}
+
+// Returns the number of keys in the subtree rooted at node
+int PersistentAVLTree::size(AVLIndex node) const {
+    return node != AVL_NIL ? nodes[node].size : 0;
+}
+
+// Recomputes the height and subtree size of a node from its children
+void PersistentAVLTree::update(AVLIndex node) {
+    nodes[node].height = std::max(height(nodes[node].left), height(nodes[node].right)) + 1;
+    nodes[node].size = size(nodes[node].left) + size(nodes[node].right) + 1;
+}
+
+// Allocates a node that belongs to the update in progress
+AVLIndex PersistentAVLTree::make(const AVLNode& node) {
+    AVLIndex index = nodes.allocate(node);
+    if (index >= fresh.size()) {
+        fresh.resize(std::max<std::size_t>(index + 1, 2 * fresh.size()), 0);
+    }
+    fresh[index] = 1;
+    created.push_back(index);
+    return index;
+}
+
+// Returns a node the writer may modify: the node itself if this update
+// created it, otherwise a copy, with the published original retired
+AVLIndex PersistentAVLTree::writable(AVLIndex node) {
+    if (fresh[node]) {
+        return node;
+    }
+    AVLIndex copy = make(nodes[node]);
+    retiring.push_back(node);
+    return copy;
+}
+
+// Drops a node that is leaving the tree
+void PersistentAVLTree::discard(AVLIndex node) {
+    if (fresh[node]) {
+        // Never published, so no reader can hold it
+        fresh[node] = 0;
+        nodes.release(node);
+    } else {
+        retiring.push_back(node);
+    }
+}
+
+// Performs a right rotation around a writable node
+AVLIndex PersistentAVLTree::rotateRight(AVLIndex y) {
+    AVLIndex x = writable(nodes[y].left);
+    nodes[y].left = nodes[x].right;
+    nodes[x].right = y;
+    update(y);
+    update(x);
+    return x;
+}
+
+// Performs a left rotation around a writable node
+AVLIndex PersistentAVLTree::rotateLeft(AVLIndex x) {
+    AVLIndex y = writable(nodes[x].right);
+    nodes[x].right = nodes[y].left;
+    nodes[y].left = x;
+    update(x);
+    update(y);
+    return y;
+}
+
+// Restores the AVL property at a writable node and returns the subtree's new root
+AVLIndex PersistentAVLTree::rebalance(AVLIndex node) {
+    update(node);
+    int balance = height(nodes[node].left) - height(nodes[node].right);
+    if (balance > 1) {
+        AVLIndex left = nodes[node].left;
+        if (height(nodes[left].left) < height(nodes[left].right)) {
+            AVLIndex rotated = rotateLeft(writable(left));
+            nodes[node].left = rotated;
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        AVLIndex right = nodes[node].right;
+        if (height(nodes[right].right) < height(nodes[right].left)) {
+            AVLIndex rotated = rotateRight(writable(right));
+            nodes[node].right = rotated;
+        }
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+// Inserts a key by path copying; returns node itself when the key was already present
+AVLIndex PersistentAVLTree::insert(AVLIndex node, int key) {
+    if (node == AVL_NIL) {
+        return make(AVLNode(key));
+    }
+    if (key < nodes[node].key) {
+        AVLIndex left = insert(nodes[node].left, key);
+        if (left == nodes[node].left) {
+            return node;
+        }
+        AVLIndex copy = writable(node);
+        nodes[copy].left = left;
+        return rebalance(copy);
+    }
+    if (key > nodes[node].key) {
+        AVLIndex right = insert(nodes[node].right, key);
+        if (right == nodes[node].right) {
+            return node;
+        }
+        AVLIndex copy = writable(node);
+        nodes[copy].right = right;
+        return rebalance(copy);
+    }
+    return node;
+}
+
+// Removes the minimum of a subtree into minKey by path copying
+AVLIndex PersistentAVLTree::deleteMin(AVLIndex node, int& minKey) {
+    if (nodes[node].left == AVL_NIL) {
+        minKey = nodes[node].key;
+        AVLIndex right = nodes[node].right;
+        discard(node);
+        return right;
+    }
+    AVLIndex left = deleteMin(nodes[node].left, minKey);
+    AVLIndex copy = writable(node);
+    nodes[copy].left = left;
+    return rebalance(copy);
+}
+
+// Deletes a key by path copying; returns node itself when the key was absent
+AVLIndex PersistentAVLTree::deleteNode(AVLIndex node, int key) {
+    if (node == AVL_NIL) {
+        return node;
+    }
+    if (key < nodes[node].key) {
+        AVLIndex left = deleteNode(nodes[node].left, key);
+        if (left == nodes[node].left) {
+            return node;
+        }
+        AVLIndex copy = writable(node);
+        nodes[copy].left = left;
+        return rebalance(copy);
+    }
+    if (key > nodes[node].key) {
+        AVLIndex right = deleteNode(nodes[node].right, key);
+        if (right == nodes[node].right) {
+            return node;
+        }
+        AVLIndex copy = writable(node);
+        nodes[copy].right = right;
+        return rebalance(copy);
+    }
+
+    AVLIndex left = nodes[node].left;
+    AVLIndex right = nodes[node].right;
+    if (left == AVL_NIL || right == AVL_NIL) {
+        discard(node);
+        return left != AVL_NIL ? left : right;
+    }
+    int successorKey;
+    AVLIndex newRight = deleteMin(right, successorKey);
+    AVLIndex copy = writable(node);
+    nodes[copy].key = successorKey;
+    nodes[copy].right = newRight;
+    return rebalance(copy);
+}
+
+// Builds a perfectly balanced subtree from sorted, distinct keys
+AVLIndex PersistentAVLTree::buildSorted(const int* keys, int count) {
+    if (count <= 0) {
+        return AVL_NIL;
+    }
+    int mid = count / 2;
+    AVLIndex node = make(AVLNode(keys[mid]));
+    AVLIndex left = buildSorted(keys, mid);
+    AVLIndex right = buildSorted(keys + mid + 1, count - mid - 1);
+    nodes[node].left = left;
+    nodes[node].right = right;
+    update(node);
+    return node;
+}
+
+// Retires every node of a published subtree
+void PersistentAVLTree::retireSubtree(AVLIndex node) {
+    if (node != AVL_NIL) {
+        retireSubtree(nodes[node].left);
+        retireSubtree(nodes[node].right);
+        retiring.push_back(node);
+    }
+}
+
+// Makes newRoot visible to readers, then retires the nodes it replaced under
+// the epoch that was current while the old version could still be pinned
+void PersistentAVLTree::publish(AVLIndex newRoot) {
+    root.store(newRoot);
+    for (AVLIndex node : created) {
+        fresh[node] = 0;
+    }
+    created.clear();
+
+    uint64_t epoch = globalEpoch.fetch_add(1);
+    if (!retiring.empty()) {
+        retired.push_back(RetiredBatch{epoch, std::vector<AVLIndex>()});
+        retired.back().nodes.swap(retiring);
+    }
+    reclaim();
+}
+
+// Frees retired batches that no active snapshot can reach. A snapshot that
+// announced epoch e loaded its root after epoch e began, so it cannot see
+// nodes retired under an epoch below e.
+void PersistentAVLTree::reclaim() {
+    uint64_t oldest = globalEpoch.load();
+    for (int i = 0; i < MaxReaders; ++i) {
+        uint64_t epoch = readers[i].epoch.load();
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    while (!retired.empty() && retired.front().epoch < oldest) {
+        for (AVLIndex node : retired.front().nodes) {
+            nodes.release(node);
+        }
+        retired.pop_front();
+    }
+}
+
+// Inserts a key and publishes the new version
+void PersistentAVLTree::insert(int key) {
+    std::lock_guard<std::mutex> guard(writeLock);
+    AVLIndex current = root.load();
+    AVLIndex updated = insert(current, key);
+    if (updated != current) {
+        publish(updated);
+    }
+}
+
+// Deletes a key and publishes the new version
+void PersistentAVLTree::deleteNode(int key) {
+    std::lock_guard<std::mutex> guard(writeLock);
+    AVLIndex current = root.load();
+    AVLIndex updated = deleteNode(current, key);
+    if (updated != current) {
+        publish(updated);
+    }
+}
+
+// Replaces the contents with the given elements in one published version
+void PersistentAVLTree::buildTree(int* elements, int size) {
+    std::vector<int> keys(elements, elements + size);
+    if (!std::is_sorted(keys.begin(), keys.end())) {
+        std::sort(keys.begin(), keys.end());
+    }
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::lock_guard<std::mutex> guard(writeLock);
+    retireSubtree(root.load());
+    publish(buildSorted(keys.data(), static_cast<int>(keys.size())));
+}
+
+// Returns a read handle on the latest published version
+PersistentAVLTree::Snapshot PersistentAVLTree::snapshot() const {
+    return Snapshot(this);
+}
+
+// Returns the number of keys in the latest published version
+int PersistentAVLTree::getSize() const {
+    return size(root.load());
+}
+
+// Returns how many retired nodes are still waiting for readers to move on
+std::size_t PersistentAVLTree::pendingReclamation() const {
+    std::lock_guard<std::mutex> guard(writeLock);
+    std::size_t pending = 0;
+    for (const RetiredBatch& batch : retired) {
+        pending += batch.nodes.size();
+    }
+    return pending;
+}
@@ -0,0 +1,384 @@
+#include "RoaringSet.h"
+#include <algorithm>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Combines two bitmaps word by word into target (OR when unite, else AND)
+inline void combineWords(uint64_t* target, const uint64_t* source, int count, bool unite) {
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= count; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i result = unite ? _mm_or_si128(a, b) : _mm_and_si128(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), result);
+    }
+#endif
+    for (; i < count; ++i) {
+        target[i] = unite ? target[i] | source[i] : target[i] & source[i];
+    }
+}
+
+} // namespace
+
+// Constructor to create an empty set
+RoaringSet::RoaringSet() : cardinality(0) {}
+
+// Returns the index of the container for a chunk, or -1
+int RoaringSet::findContainer(uint16_t high) const {
+    int lo = 0;
+    int hi = static_cast<int>(containers.size()) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (containers[mid].high == high) {
+            return mid;
+        }
+        if (containers[mid].high < high) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+// Checks if a container holds a 16-bit value
+bool RoaringSet::containerContains(const Container& container, uint16_t low) {
+    if (container.type == BitmapContainer) {
+        return (container.words[low / 64] >> (low % 64)) & 1;
+    }
+    if (container.type == ArrayContainer) {
+        return std::binary_search(container.values.begin(), container.values.end(), low);
+    }
+    // Last run starting at or before low
+    int lo = 0;
+    int hi = static_cast<int>(container.values.size() / 2) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (container.values[2 * mid] <= low) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return hi >= 0 && low - container.values[2 * hi] <= container.values[2 * hi + 1];
+}
+
+// Recounts the keys of a bitmap container
+void RoaringSet::countBitmap(Container& container) {
+    int count = 0;
+    for (uint64_t word : container.words) {
+        count += __builtin_popcountll(word);
+    }
+    container.count = count;
+}
+
+// Converts an array or run container into a bitmap
+void RoaringSet::toBitmap(Container& container) {
+    if (container.type == BitmapContainer) {
+        return;
+    }
+    std::vector<uint64_t> words(BitmapWords, 0);
+    if (container.type == ArrayContainer) {
+        for (uint16_t low : container.values) {
+            words[low / 64] |= uint64_t(1) << (low % 64);
+        }
+    } else {
+        for (std::size_t i = 0; i < container.values.size(); i += 2) {
+            uint32_t start = container.values[i];
+            for (uint32_t low = start; low <= start + container.values[i + 1]; ++low) {
+                words[low / 64] |= uint64_t(1) << (low % 64);
+            }
+        }
+    }
+    container.words.swap(words);
+    std::vector<uint16_t>().swap(container.values);
+    container.type = BitmapContainer;
+}
+
+// Converts a bitmap or run container into a sorted array
+void RoaringSet::toArray(Container& container) {
+    if (container.type == ArrayContainer) {
+        return;
+    }
+    std::vector<uint16_t> values;
+    values.reserve(container.count);
+    if (container.type == BitmapContainer) {
+        for (int i = 0; i < BitmapWords; ++i) {
+            for (uint64_t word = container.words[i]; word; word &= word - 1) {
+                values.push_back(static_cast<uint16_t>(i * 64 + __builtin_ctzll(word)));
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < container.values.size(); i += 2) {
+            uint32_t start = container.values[i];
+            for (uint32_t low = start; low <= start + container.values[i + 1]; ++low) {
+                values.push_back(static_cast<uint16_t>(low));
+            }
+        }
+    }
+    container.values.swap(values);
+    std::vector<uint64_t>().swap(container.words);
+    container.type = ArrayContainer;
+}
+
+// Turns a run container back into whichever of array or bitmap fits its count
+void RoaringSet::expandRuns(Container& container) {
+    if (container.type != RunContainer) {
+        return;
+    }
+    if (container.count > ArrayLimit) {
+        toBitmap(container);
+    } else {
+        toArray(container);
+    }
+}
+
+// Turns a bitmap that has become sparse into an array
+void RoaringSet::shrinkBitmap(Container& container) {
+    if (container.type == BitmapContainer && container.count <= ArrayLimit) {
+        toArray(container);
+    }
+}
+
+// Counts the runs of consecutive values in a container
+int RoaringSet::countRuns(const Container& container) {
+    if (container.type == RunContainer) {
+        return static_cast<int>(container.values.size() / 2);
+    }
+    int runs = 0;
+    if (container.type == ArrayContainer) {
+        for (std::size_t i = 0; i < container.values.size(); ++i) {
+            if (i == 0 || container.values[i] != container.values[i - 1] + 1) {
+                ++runs;
+            }
+        }
+        return runs;
+    }
+    for (int i = 0; i < BitmapWords; ++i) {
+        uint64_t word = container.words[i];
+        uint64_t carry = i > 0 ? container.words[i - 1] >> 63 : 0;
+        // A run starts at every set bit whose lower neighbour is clear
+        runs += __builtin_popcountll(word & ~((word << 1) | carry));
+    }
+    return runs;
+}
+
+// Converts a container into (start, length - 1) runs
+void RoaringSet::toRuns(Container& container) {
+    if (container.type == RunContainer) {
+        return;
+    }
+    toArray(container);
+    std::vector<uint16_t> runs;
+    for (std::size_t i = 0; i < container.values.size();) {
+        std::size_t end = i;
+        while (end + 1 < container.values.size() && container.values[end + 1] == container.values[end] + 1) {
+            ++end;
+        }
+        runs.push_back(container.values[i]);
+        runs.push_back(static_cast<uint16_t>(end - i));
+        i = end + 1;
+    }
+    container.values.swap(runs);
+    container.type = RunContainer;
+}
+
+// Inserts a key; returns false if it was already present
+bool RoaringSet::add(int key) {
+    uint32_t value = toUnsigned(key);
+    uint16_t high = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value);
+
+    auto position = std::lower_bound(containers.begin(), containers.end(), high,
+                                     [](const Container& container, uint16_t h) { return container.high < h; });
+    if (position == containers.end() || position->high != high) {
+        position = containers.insert(position, Container{high, ArrayContainer, 0, {}, {}});
+    }
+    Container& container = *position;
+    if (containerContains(container, low)) {
+        return false;
+    }
+    expandRuns(container);
+    if (container.type == ArrayContainer) {
+        container.values.insert(std::lower_bound(container.values.begin(), container.values.end(), low), low);
+        if (++container.count > ArrayLimit) {
+            toBitmap(container);
+        }
+    } else {
+        container.words[low / 64] |= uint64_t(1) << (low % 64);
+        ++container.count;
+    }
+    ++cardinality;
+    return true;
+}
+
+// Removes a key; returns false if it was not present
+bool RoaringSet::remove(int key) {
+    uint32_t value = toUnsigned(key);
+    int index = findContainer(static_cast<uint16_t>(value >> 16));
+    uint16_t low = static_cast<uint16_t>(value);
+    if (index < 0 || !containerContains(containers[index], low)) {
+        return false;
+    }
+    Container& container = containers[index];
+    expandRuns(container);
+    if (container.type == ArrayContainer) {
+        container.values.erase(std::lower_bound(container.values.begin(), container.values.end(), low));
+        --container.count;
+    } else {
+        container.words[low / 64] &= ~(uint64_t(1) << (low % 64));
+        --container.count;
+        shrinkBitmap(container);
+    }
+    if (container.count == 0) {
+        containers.erase(containers.begin() + index);
+    }
+    --cardinality;
+    return true;
+}
+
+// Checks if a key is in the set
+bool RoaringSet::contains(int key) const {
+    uint32_t value = toUnsigned(key);
+    int index = findContainer(static_cast<uint16_t>(value >> 16));
+    return index >= 0 && containerContains(containers[index], static_cast<uint16_t>(value));
+}
+
+// Removes every key
+void RoaringSet::clear() {
+    containers.clear();
+    cardinality = 0;
+}
+
+// Stores each container in whichever of array, bitmap or runs is smallest
+void RoaringSet::optimize() {
+    for (Container& container : containers) {
+        std::size_t runBytes = 4 * static_cast<std::size_t>(countRuns(container));
+        std::size_t plainBytes = container.count > ArrayLimit ? BitmapWords * 8 : 2 * static_cast<std::size_t>(container.count);
+        if (runBytes < plainBytes) {
+            toRuns(container);
+        } else if (container.type == RunContainer) {
+            expandRuns(container);
+        }
+    }
+}
+
+// Adds every value of source into target
+void RoaringSet::unionContainer(Container& target, const Container& source) {
+    if (target.type == ArrayContainer && source.type == ArrayContainer &&
+        target.count + source.count <= ArrayLimit) {
+        std::vector<uint16_t> merged;
+        merged.reserve(target.count + source.count);
+        std::set_union(target.values.begin(), target.values.end(), source.values.begin(), source.values.end(),
+                       std::back_inserter(merged));
+        target.values.swap(merged);
+        target.count = static_cast<int>(target.values.size());
+        return;
+    }
+    toBitmap(target);
+    if (source.type == BitmapContainer) {
+        combineWords(target.words.data(), source.words.data(), BitmapWords, true);
+    } else {
+        Container copy = source;
+        toBitmap(copy);
+        combineWords(target.words.data(), copy.words.data(), BitmapWords, true);
+    }
+    countBitmap(target);
+}
+
+// Keeps only the values of target that source also holds
+void RoaringSet::intersectContainer(Container& target, const Container& source) {
+    expandRuns(target);
+    if (target.type == ArrayContainer) {
+        std::vector<uint16_t> kept;
+        for (uint16_t low : target.values) {
+            if (containerContains(source, low)) {
+                kept.push_back(low);
+            }
+        }
+        target.values.swap(kept);
+        target.count = static_cast<int>(target.values.size());
+        return;
+    }
+    if (source.type == BitmapContainer) {
+        combineWords(target.words.data(), source.words.data(), BitmapWords, false);
+        countBitmap(target);
+    } else {
+        // The sparse side decides: keep the source values set in target
+        Container copy = source;
+        expandRuns(copy);
+        if (copy.type == ArrayContainer) {
+            std::vector<uint16_t> kept;
+            for (uint16_t low : copy.values) {
+                if ((target.words[low / 64] >> (low % 64)) & 1) {
+                    kept.push_back(low);
+                }
+            }
+            target.values.swap(kept);
+            std::vector<uint64_t>().swap(target.words);
+            target.type = ArrayContainer;
+            target.count = static_cast<int>(target.values.size());
+            return;
+        }
+        combineWords(target.words.data(), copy.words.data(), BitmapWords, false);
+        countBitmap(target);
+    }
+    shrinkBitmap(target);
+}
+
+// Adds every key of other to this set
+void RoaringSet::unionWith(const RoaringSet& other) {
+    std::vector<Container> merged;
+    merged.reserve(containers.size() + other.containers.size());
+    std::size_t i = 0;
+    std::size_t j = 0;
+    cardinality = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].high < other.containers[j].high)) {
+            merged.push_back(std::move(containers[i++]));
+        } else if (i == containers.size() || other.containers[j].high < containers[i].high) {
+            merged.push_back(other.containers[j++]);
+        } else {
+            unionContainer(containers[i], other.containers[j++]);
+            merged.push_back(std::move(containers[i++]));
+        }
+        cardinality += merged.back().count;
+    }
+    containers.swap(merged);
+}
+
+// Keeps only the keys that other also holds
+void RoaringSet::intersectWith(const RoaringSet& other) {
+    std::vector<Container> kept;
+    std::size_t j = 0;
+    cardinality = 0;
+    for (Container& container : containers) {
+        while (j < other.containers.size() && other.containers[j].high < container.high) {
+            ++j;
+        }
+        if (j == other.containers.size() || other.containers[j].high != container.high) {
+            continue;
+        }
+        intersectContainer(container, other.containers[j]);
+        if (container.count > 0) {
+            cardinality += container.count;
+            kept.push_back(std::move(container));
+        }
+    }
+    containers.swap(kept);
+}
+
+// Returns the bytes held by the containers
+std::size_t RoaringSet::bytes() const {
+    std::size_t total = containers.capacity() * sizeof(Container);
+    for (const Container& container : containers) {
+        total += container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+    }
+    return total;
+}
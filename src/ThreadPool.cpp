@@ -0,0 +1,73 @@
+#include "ThreadPool.h"
+
+// Constructor to start threadCount - 1 worker threads (at least one worker in total)
+ThreadPool::ThreadPool(int threadCount) : task(nullptr), count(0), next(0), busy(0), generation(0), stopping(false) {
+    for (int worker = 1; worker < threadCount; ++worker) {
+        threads.emplace_back(&ThreadPool::loop, this, worker);
+    }
+}
+
+// Destructor to stop and join the workers
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// Claims indices of the current job until none are left
+void ThreadPool::work(int worker) {
+    for (int index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+        (*task)(index, worker);
+    }
+}
+
+// Body of a worker thread: waits for each new job and helps finish it
+void ThreadPool::loop(int worker) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        work(worker);
+        std::lock_guard<std::mutex> guard(lock);
+        if (--busy == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+// Runs task(index, worker) for every index in [0, count) and waits for all of them
+void ThreadPool::run(int count, const std::function<void(int index, int worker)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> serial(runLock);
+    if (threads.empty() || count == 1) {
+        for (int index = 0; index < count; ++index) {
+            task(index, 0);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        this->task = &task;
+        this->count = count;
+        next.store(0);
+        busy = static_cast<int>(threads.size());
+        ++generation;
+    }
+    wake.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> guard(lock);
+    finished.wait(guard, [&] { return busy == 0; });
+}